@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <unistd.h>
+#include "allocDiagnostics.h"
+
+/**
+ * Shared helpers for the benchmark executables.
+ * Each benchmark prints one table row per configuration.
+ */
+
+// Debug builds print allocator diagnostics (see allocDiagnostics.h);
+// turning the printing off keeps pool creation messages out of the tables
+// and the timed loops free of console writes
+inline void silence_diagnostics() {
+    set_diagnostics_output(false);
+}
+
+inline void restore_diagnostics() {
+    set_diagnostics_output(true);
+}
+
+// Run fn() once and return elapsed wall time in nanoseconds
+template <typename Fn>
+double time_ns(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+// Keep the optimizer from discarding a computed value
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Resident set size of this process in bytes (Linux; 0 elsewhere)
+inline size_t current_rss_bytes() {
+    size_t pages_total = 0;
+    size_t pages_resident = 0;
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (!statm) {
+        return 0;
+    }
+    if (std::fscanf(statm, "%zu %zu", &pages_total, &pages_resident) != 2) {
+        pages_resident = 0;
+    }
+    std::fclose(statm);
+    return pages_resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
@@ -0,0 +1,104 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "arenaAlloc.h"
+#include "benchUtil.h"
+
+/**
+ * Per-request scratch memory: each simulated request parses a request
+ * line, 20-40 headers (name and value strings plus a header record), a
+ * small query-parameter array and a 1-8 KB body buffer, then drops
+ * everything. malloc frees every allocation; the arena calls reset().
+ */
+
+const size_t kRequests = 200000;
+
+struct Header {
+    char* name;
+    char* value;
+    Header* next;
+};
+
+// Sizes for one request, drawn up front so both allocators see the same sequence
+struct RequestShape {
+    size_t num_headers;
+    size_t name_len[40];
+    size_t value_len[40];
+    size_t num_params;
+    size_t body_len;
+};
+
+template <typename Alloc>
+size_t parse_request(const RequestShape& shape, Alloc&& alloc) {
+    size_t touched = 0;
+    char* line = static_cast<char*>(alloc(96, 1));
+    line[0] = 'G';
+    Header* headers = nullptr;
+    for (size_t i = 0; i < shape.num_headers; ++i) {
+        Header* header = static_cast<Header*>(alloc(sizeof(Header), alignof(Header)));
+        header->name = static_cast<char*>(alloc(shape.name_len[i], 1));
+        header->value = static_cast<char*>(alloc(shape.value_len[i], 1));
+        std::memset(header->name, 'n', shape.name_len[i]);
+        std::memset(header->value, 'v', shape.value_len[i]);
+        header->next = headers;
+        headers = header;
+        touched += shape.name_len[i] + shape.value_len[i];
+    }
+    auto* params = static_cast<uint64_t*>(alloc(shape.num_params * sizeof(uint64_t), alignof(uint64_t)));
+    for (size_t i = 0; i < shape.num_params; ++i) {
+        params[i] = i;
+    }
+    char* body = static_cast<char*>(alloc(shape.body_len, 16));
+    std::memset(body, 'b', shape.body_len);
+    return touched + shape.body_len + static_cast<size_t>(headers != nullptr) + line[0];
+}
+
+int main() {
+    std::mt19937_64 rng(3);
+    std::vector<RequestShape> shapes(256);
+    for (auto& shape : shapes) {
+        shape.num_headers = 20 + rng() % 21;
+        for (size_t i = 0; i < shape.num_headers; ++i) {
+            shape.name_len[i] = 4 + rng() % 20;
+            shape.value_len[i] = 8 + rng() % 120;
+        }
+        shape.num_params = 1 + rng() % 16;
+        shape.body_len = 1024 + rng() % 7168;
+    }
+    
+    // malloc/free: every allocation is freed individually at the end of the request
+    std::vector<void*> live;
+    live.reserve(128);
+    size_t sink = 0;
+    double malloc_ns = time_ns([&] {
+        for (size_t r = 0; r < kRequests; ++r) {
+            sink += parse_request(shapes[r % shapes.size()], [&](size_t size, size_t) {
+                void* ptr = std::malloc(size);
+                live.push_back(ptr);
+                return ptr;
+            });
+            for (void* ptr : live) {
+                std::free(ptr);
+            }
+            live.clear();
+        }
+    });
+    
+    ArenaAllocator arena(16 * 1024);
+    double arena_ns = time_ns([&] {
+        for (size_t r = 0; r < kRequests; ++r) {
+            sink += parse_request(shapes[r % shapes.size()], [&](size_t size, size_t alignment) {
+                return arena.allocate(size, alignment);
+            });
+            arena.reset();
+        }
+    });
+    do_not_optimize(sink);
+    
+    std::printf("%-12s %14s\n", "allocator", "ns/request");
+    std::printf("%-12s %14.1f\n", "malloc", malloc_ns / kRequests);
+    std::printf("%-12s %14.1f   (%zu chunks kept)\n", "arena", arena_ns / kRequests, arena.get_num_chunks());
+    return 0;
+}
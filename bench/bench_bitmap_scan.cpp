@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "fixAlloc.h"
+#include "benchUtil.h"
+
+/**
+ * Worst-case free-block search: every block is used except the last one,
+ * so each search has to walk past the whole occupied prefix.
+ *
+ * Compares the original one-bit-at-a-time std::vector<bool> scan, a flat
+ * uint64_t word scan, and FixedAllocator itself, whose summary levels
+ * reach the free bit with one ctz per level regardless of pool size.
+ */
+
+// Previous FixedAllocator search over std::vector<bool>
+struct BoolBitmap {
+    std::vector<bool> bits;
+
+    explicit BoolBitmap(size_t n) : bits(n, false) {}
+
+    void set(size_t i) { bits[i] = true; }
+    void clear(size_t i) { bits[i] = false; }
+
+    size_t find_free_block() const {
+        for (size_t i = 0; i < bits.size(); ++i) {
+            if (!bits[i]) {
+                return i;
+            }
+        }
+        return bits.size();
+    }
+};
+
+// Flat word scan without summary levels
+struct WordBitmap {
+    std::vector<uint64_t> words;
+    size_t num_blocks;
+
+    explicit WordBitmap(size_t n) : words((n + 63) / 64, 0), num_blocks(n) {}
+
+    void set(size_t i) { words[i / 64] |= uint64_t(1) << (i % 64); }
+    void clear(size_t i) { words[i / 64] &= ~(uint64_t(1) << (i % 64)); }
+
+    size_t find_free_block() const {
+        for (size_t w = 0; w < words.size(); ++w) {
+            if (words[w] != ~uint64_t(0)) {
+                return w * 64 + static_cast<size_t>(__builtin_ctzll(~words[w]));
+            }
+        }
+        return num_blocks;
+    }
+};
+
+// Fill all but the last block, then time search + mark used + mark free
+template <typename Bitmap>
+double worst_case_ns(size_t num_blocks, size_t iterations) {
+    Bitmap bitmap(num_blocks);
+    for (size_t i = 0; i + 1 < num_blocks; ++i) {
+        bitmap.set(i);
+    }
+    return time_ns([&] {
+        for (size_t i = 0; i < iterations; ++i) {
+            size_t index = bitmap.find_free_block();
+            bitmap.set(index);
+            do_not_optimize(index);
+            bitmap.clear(index);
+        }
+    }) / iterations;
+}
+
+// Same workload through FixedAllocator::allocate()/deallocate()
+double allocator_worst_case_ns(size_t num_blocks, size_t iterations) {
+    silence_diagnostics();
+    double ns;
+    {
+        FixedAllocator allocator(8, num_blocks);
+        for (size_t i = 0; i + 1 < num_blocks; ++i) {
+            allocator.allocate();
+        }
+        ns = time_ns([&] {
+            for (size_t i = 0; i < iterations; ++i) {
+                void* ptr = allocator.allocate();
+                do_not_optimize(ptr);
+                allocator.deallocate(ptr);
+            }
+        }) / iterations;
+    }
+    restore_diagnostics();
+    return ns;
+}
+
+int main() {
+    const size_t sizes[] = {1024, 64 * 1024, 16 * 1024 * 1024};
+
+    std::printf("%12s %16s %16s %16s\n", "blocks", "vector<bool> ns", "uint64+ctz ns", "summary ns");
+
+    for (size_t num_blocks : sizes) {
+        // Scale iterations so each configuration scans roughly the same number of bits
+        size_t iterations = std::max<size_t>(8, (size_t(1) << 28) / num_blocks);
+
+        double bool_ns = worst_case_ns<BoolBitmap>(num_blocks, iterations);
+        double word_ns = worst_case_ns<WordBitmap>(num_blocks, iterations);
+        double summary_ns = allocator_worst_case_ns(num_blocks, iterations);
+
+        std::printf("%12zu %16.1f %16.1f %16.1f\n", num_blocks, bool_ns, word_ns, summary_ns);
+    }
+    return 0;
+}
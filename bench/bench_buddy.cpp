@@ -0,0 +1,97 @@
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+#include "buddyAlloc.h"
+#include "fixAlloc.h"
+#include "benchUtil.h"
+
+/**
+ * Buffers from 4 KB to 4 MB (log-uniform sizes): a working set of kLive
+ * buffers where each step frees a random one and allocates a new size.
+ * Compares malloc, the status quo of one FixedAllocator per power of two
+ * (each sized for the whole working set at its size), and one
+ * BuddyAllocator region.
+ */
+
+const size_t kLive = 48;
+const size_t kSteps = 1000000;
+const size_t kMinShift = 12;  // 4 KB
+const size_t kMaxShift = 22;  // 4 MB
+
+int main() {
+    std::mt19937_64 rng(11);
+    std::vector<size_t> sizes(4096);
+    for (auto& size : sizes) {
+        size_t shift = kMinShift + rng() % (kMaxShift - kMinShift);
+        size = (size_t(1) << shift) + rng() % (size_t(1) << shift);  // [2^shift, 2^(shift+1))
+    }
+    std::vector<size_t> victims(kSteps);
+    for (auto& victim : victims) {
+        victim = rng() % kLive;
+    }
+    
+    // Runs the churn; alloc(size) returns a buffer, release(ptr, size) frees it
+    auto churn = [&](auto&& alloc, auto&& release) {
+        std::vector<void*> live(kLive);
+        std::vector<size_t> live_size(kLive);
+        for (size_t i = 0; i < kLive; ++i) {
+            live_size[i] = sizes[i];
+            live[i] = alloc(live_size[i]);
+        }
+        size_t failed = 0;
+        double ns = time_ns([&] {
+            for (size_t step = 0; step < kSteps; ++step) {
+                size_t slot = victims[step];
+                release(live[slot], live_size[slot]);
+                live_size[slot] = sizes[step % sizes.size()];
+                live[slot] = alloc(live_size[slot]);
+                if (live[slot]) {
+                    static_cast<char*>(live[slot])[0] = 1;
+                } else {
+                    ++failed;
+                }
+            }
+        });
+        for (size_t i = 0; i < kLive; ++i) {
+            release(live[i], live_size[i]);
+        }
+        if (failed) {
+            std::printf("  (%zu allocations failed)\n", failed);
+        }
+        return ns / kSteps;
+    };
+    
+    double malloc_ns = churn([](size_t size) { return std::malloc(size); },
+                             [](void* ptr, size_t) { std::free(ptr); });
+    
+    // One pool per block size 8 KB .. 8 MB, kLive blocks each
+    FixedAllocatorOptions options;
+    options.mode = AllocationMode::FreeList;
+    options.backing = PoolBacking::Mmap;
+    options.lazy_commit = true;
+    std::vector<std::unique_ptr<FixedAllocator>> pools;
+    size_t pools_reserved = 0;
+    for (size_t shift = kMinShift + 1; shift <= kMaxShift + 1; ++shift) {
+        pools.push_back(std::make_unique<FixedAllocator>(size_t(1) << shift, kLive, options));
+        pools_reserved += (size_t(1) << shift) * kLive;
+    }
+    auto pool_for = [&](size_t size) {
+        size_t shift = 64 - static_cast<size_t>(__builtin_clzll(size - 1));
+        return pools[shift - kMinShift - 1].get();
+    };
+    double pools_ns = churn([&](size_t size) { return pool_for(size)->allocate(); },
+                            [&](void* ptr, size_t size) { pool_for(size)->deallocate(ptr); });
+    
+    // Worst case live bytes is kLive * 8 MB; a quarter of that is plenty in practice
+    BuddyAllocator buddy(kLive * (size_t(8) << 20) / 4, 4096, PoolBacking::Mmap);
+    double buddy_ns = churn([&](size_t size) { return buddy.allocate(size); },
+                            [&](void* ptr, size_t) { buddy.deallocate(ptr); });
+    
+    std::printf("%-24s %12s %14s\n", "allocator", "ns/op pair", "reserved MB");
+    std::printf("%-24s %12.1f %14s\n", "malloc", malloc_ns, "-");
+    std::printf("%-24s %12.1f %14zu\n", "FixedAllocator x 11", pools_ns, pools_reserved >> 20);
+    std::printf("%-24s %12.1f %14zu\n", "BuddyAllocator", buddy_ns, buddy.get_capacity() >> 20);
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <cstdio>
+#include <vector>
+#include "fixAlloc.h"
+#include "benchUtil.h"
+
+/**
+ * Batch allocate/free of 16-256 blocks: one allocate()/deallocate() call
+ * per block versus a single allocate_bulk()/deallocate_bulk() per batch.
+ * Reports nanoseconds per block for a full allocate + free round trip.
+ */
+
+double round_trip_ns(AllocationMode mode, size_t batch, bool bulk, size_t rounds) {
+    FixedAllocatorOptions options;
+    options.mode = mode;
+    silence_diagnostics();
+    double ns;
+    {
+        FixedAllocator allocator(64, 1 << 20, options);
+        // Keep part of the pool busy so batches land mid-bitmap
+        std::vector<void*> resident(1 << 19);
+        allocator.allocate_bulk(resident.data(), resident.size());
+
+        std::vector<void*> ptrs(batch);
+        ns = time_ns([&] {
+            for (size_t r = 0; r < rounds; ++r) {
+                if (bulk) {
+                    allocator.allocate_bulk(ptrs.data(), batch);
+                    do_not_optimize(ptrs[0]);
+                    allocator.deallocate_bulk(ptrs.data(), batch);
+                } else {
+                    for (auto& ptr : ptrs) {
+                        ptr = allocator.allocate();
+                    }
+                    do_not_optimize(ptrs[0]);
+                    for (void* ptr : ptrs) {
+                        allocator.deallocate(ptr);
+                    }
+                }
+            }
+        }) / (rounds * batch);
+    }
+    restore_diagnostics();
+    return ns;
+}
+
+int main() {
+    const size_t batches[] = {16, 64, 256};
+    const size_t blocks_per_row = 4 * 1000 * 1000;
+
+    std::printf("%8s %10s %14s %14s\n", "mode", "batch", "single ns/blk", "bulk ns/blk");
+    for (AllocationMode mode : {AllocationMode::Bitmap, AllocationMode::FreeList}) {
+        const char* name = (mode == AllocationMode::Bitmap) ? "bitmap" : "freelist";
+        for (size_t batch : batches) {
+            size_t rounds = blocks_per_row / batch;
+            double single = round_trip_ns(mode, batch, false, rounds);
+            double bulk = round_trip_ns(mode, batch, true, rounds);
+            std::printf("%8s %10zu %14.1f %14.1f\n", name, batch, single, bulk);
+        }
+    }
+    return 0;
+}
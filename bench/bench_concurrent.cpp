@@ -0,0 +1,95 @@
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "fixAlloc.h"
+#include "concurrentAlloc.h"
+#include "benchUtil.h"
+
+/**
+ * Multi-threaded allocate/free throughput from 1 to 64 threads.
+ * Each thread repeatedly allocates a small working set and frees it.
+ * Compares a FixedAllocator behind a mutex with ConcurrentFixedAllocator
+ * in Bitmap mode and in FreeList mode (Treiber stack), with and without the
+ * double-free side bitmap.
+ */
+
+// The configuration this replaces: one global lock around the pool
+struct MutexFixedAllocator {
+    FixedAllocator allocator;
+    std::mutex lock;
+
+    MutexFixedAllocator(size_t block_size, size_t num_blocks) : allocator(block_size, num_blocks) {}
+
+    void* allocate() {
+        std::lock_guard<std::mutex> guard(lock);
+        return allocator.allocate();
+    }
+
+    bool deallocate(void* ptr) {
+        std::lock_guard<std::mutex> guard(lock);
+        return allocator.deallocate(ptr);
+    }
+};
+
+const size_t kWorkingSet = 32;
+const size_t kOpsPerThread = 200000;
+
+// Million allocate+free pairs per second across all threads
+template <typename Allocator>
+double throughput_mops(Allocator& allocator, size_t num_threads) {
+    double ns = time_ns([&] {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&] {
+                void* ptrs[kWorkingSet];
+                for (size_t done = 0; done < kOpsPerThread; done += kWorkingSet) {
+                    for (auto& ptr : ptrs) {
+                        ptr = allocator.allocate();
+                    }
+                    do_not_optimize(ptrs[0]);
+                    for (void* ptr : ptrs) {
+                        allocator.deallocate(ptr);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+    return (num_threads * kOpsPerThread) / ns * 1000.0;
+}
+
+int main() {
+    const size_t thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+    const size_t num_blocks = 64 * kWorkingSet * 4;
+
+    std::printf("hardware threads: %u\n\n", std::thread::hardware_concurrency());
+    FixedAllocatorOptions treiber;
+    treiber.mode = AllocationMode::FreeList;
+    FixedAllocatorOptions treiber_unchecked = treiber;
+    treiber_unchecked.detect_double_free = false;
+
+    std::printf("%8s %12s %12s %12s %16s   (Mops/s)\n",
+                "threads", "mutex", "atomic bmp", "treiber", "treiber no-chk");
+
+    silence_diagnostics();
+    for (size_t num_threads : thread_counts) {
+        MutexFixedAllocator locked(64, num_blocks);
+        ConcurrentFixedAllocator bitmap(64, num_blocks);
+        ConcurrentFixedAllocator stack(64, num_blocks, treiber);
+        ConcurrentFixedAllocator stack_unchecked(64, num_blocks, treiber_unchecked);
+        double locked_mops = throughput_mops(locked, num_threads);
+        double bitmap_mops = throughput_mops(bitmap, num_threads);
+        double stack_mops = throughput_mops(stack, num_threads);
+        double unchecked_mops = throughput_mops(stack_unchecked, num_threads);
+
+        restore_diagnostics();
+        std::printf("%8zu %12.2f %12.2f %12.2f %16.2f\n",
+                    num_threads, locked_mops, bitmap_mops, stack_mops, unchecked_mops);
+        silence_diagnostics();
+    }
+    restore_diagnostics();
+    return 0;
+}
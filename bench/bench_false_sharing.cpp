@@ -0,0 +1,78 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <thread>
+#include <vector>
+#include "concurrentAlloc.h"
+#include "benchUtil.h"
+
+/**
+ * False sharing between pooled objects: one 48-byte object per thread,
+ * allocated back to back from a shared pool, each thread incrementing the
+ * counter in its own object. With pointer alignment neighbouring objects
+ * share cache lines; cache_line_isolate (and alignment = 128) gives every
+ * object its own line(s). Only shows a difference with real parallelism.
+ */
+
+struct Counter {
+    std::atomic<uint64_t> value;
+    char payload[40];
+};
+static_assert(sizeof(Counter) == 48, "Counter should be 48 bytes");
+
+const size_t kIncrements = 20000000;
+
+// Million increments per second across all threads
+double increments_mops(const FixedAllocatorOptions& options, size_t num_threads) {
+    ConcurrentFixedAllocator allocator(sizeof(Counter), num_threads, options);
+    std::vector<Counter*> counters(num_threads);
+    for (auto& counter : counters) {
+        counter = new (allocator.allocate()) Counter();
+    }
+    
+    double ns = time_ns([&] {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t] {
+                std::atomic<uint64_t>& value = counters[t]->value;
+                for (size_t i = 0; i < kIncrements; ++i) {
+                    value.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+    
+    for (Counter* counter : counters) {
+        counter->~Counter();
+        allocator.deallocate(counter);
+    }
+    return (num_threads * kIncrements) / ns * 1000.0;
+}
+
+int main() {
+    const size_t thread_counts[] = {1, 2, 4, 8};
+    
+    FixedAllocatorOptions packed;
+    FixedAllocatorOptions isolated;
+    isolated.cache_line_isolate = true;
+    FixedAllocatorOptions isolated_pair;
+    isolated_pair.alignment = 128;
+    
+    std::printf("hardware threads: %u\n\n", std::thread::hardware_concurrency());
+    std::printf("%8s %14s %14s %14s   (Mincrements/s)\n",
+                "threads", "packed (48 B)", "isolate (64 B)", "align 128");
+    
+    silence_diagnostics();
+    for (size_t num_threads : thread_counts) {
+        double packed_mops = increments_mops(packed, num_threads);
+        double isolated_mops = increments_mops(isolated, num_threads);
+        double pair_mops = increments_mops(isolated_pair, num_threads);
+        std::printf("%8zu %14.1f %14.1f %14.1f\n", num_threads, packed_mops, isolated_mops, pair_mops);
+    }
+    restore_diagnostics();
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "fixAlloc.h"
+#include "benchUtil.h"
+
+/**
+ * Steady-state churn: fill the pool to a target occupancy, then repeatedly
+ * free a random live block and allocate a new one. Compares first fit and
+ * next fit in Bitmap mode, with the O(1) free list as a reference.
+ */
+
+double churn_ns(const FixedAllocatorOptions& options, size_t num_blocks, double occupancy, size_t ops) {
+    silence_diagnostics();
+    double ns;
+    {
+        FixedAllocator allocator(8, num_blocks, options);
+        std::vector<void*> live(static_cast<size_t>(num_blocks * occupancy));
+        for (auto& ptr : live) {
+            ptr = allocator.allocate();
+        }
+
+        // Pre-generate victims so the RNG isn't timed
+        std::mt19937_64 rng(42);
+        std::vector<size_t> victims(ops);
+        for (auto& v : victims) {
+            v = rng() % live.size();
+        }
+
+        ns = time_ns([&] {
+            for (size_t i = 0; i < ops; ++i) {
+                void*& slot = live[victims[i]];
+                allocator.deallocate(slot);
+                slot = allocator.allocate();
+            }
+        }) / ops;
+    }
+    restore_diagnostics();
+    return ns;
+}
+
+int main() {
+    const size_t num_blocks = 4 * 1024 * 1024;
+    const size_t ops = 2 * 1000 * 1000;
+    const double occupancies[] = {0.50, 0.90, 0.99};
+
+    FixedAllocatorOptions first_fit;
+    FixedAllocatorOptions next_fit;
+    next_fit.fit = FitPolicy::NextFit;
+    FixedAllocatorOptions free_list;
+    free_list.mode = AllocationMode::FreeList;
+
+    std::printf("%zu blocks, %zu free+allocate pairs per row\n\n", num_blocks, ops);
+    std::printf("%10s %14s %14s %14s\n", "occupancy", "first-fit ns", "next-fit ns", "free-list ns");
+
+    for (double occupancy : occupancies) {
+        double ff = churn_ns(first_fit, num_blocks, occupancy, ops);
+        double nf = churn_ns(next_fit, num_blocks, occupancy, ops);
+        double fl = churn_ns(free_list, num_blocks, occupancy, ops);
+        std::printf("%9.0f%% %14.1f %14.1f %14.1f\n", occupancy * 100, ff, nf, fl);
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "fixAlloc.h"
+#include "benchUtil.h"
+
+/**
+ * TLB pressure on a large pool: 512 MB of 64-byte blocks, half live, then
+ * random free / allocate / write traffic spread over the whole pool. Compares
+ * the pool backings; the "actual" column shows what was used after any
+ * fallback (HugeTLB needs pages reserved in /proc/sys/vm/nr_hugepages).
+ */
+
+const size_t kBlockSize = 64;
+const size_t kBlocks = size_t(8) << 20;  // 512 MB
+const size_t kOps = 4000000;
+
+// AnonHugePages from /proc/self/smaps_rollup, in MB (0 if unavailable)
+double anon_huge_mb() {
+    std::ifstream smaps("/proc/self/smaps_rollup");
+    std::string key;
+    size_t kb = 0;
+    while (smaps >> key) {
+        if (key == "AnonHugePages:") {
+            smaps >> kb;
+            break;
+        }
+    }
+    return kb / 1024.0;
+}
+
+void run(PoolBacking backing) {
+    FixedAllocatorOptions options;
+    options.backing = backing;
+    FixedAllocator allocator(kBlockSize, kBlocks, options);
+
+    std::vector<void*> live(kBlocks / 2);
+    for (auto& ptr : live) {
+        ptr = allocator.allocate();
+    }
+    // Scatter the live set so freed slots land all over the pool
+    std::mt19937_64 rng(42);
+    for (size_t i = 0; i < live.size(); ++i) {
+        std::swap(live[i], live[rng() % live.size()]);
+        if (i % 2 == 0) {
+            allocator.deallocate(live[i]);
+            live[i] = allocator.allocate();
+        }
+    }
+
+    double ns = time_ns([&] {
+        for (size_t i = 0; i < kOps; ++i) {
+            size_t slot = rng() % live.size();
+            allocator.deallocate(live[slot]);
+            void* ptr = allocator.allocate();
+            std::memset(ptr, static_cast<int>(i), kBlockSize);
+            live[slot] = ptr;
+        }
+    });
+
+    std::printf("%-22s %-22s %10.1f %12.1f\n",
+                pool_backing_name(backing), pool_backing_name(allocator.get_backing()),
+                ns / kOps, anon_huge_mb());
+}
+
+int main() {
+    std::printf("%-22s %-22s %10s %12s\n",
+                "requested", "actual", "ns/op", "AnonHuge MB");
+    silence_diagnostics();
+    run(PoolBacking::Heap);
+    run(PoolBacking::Mmap);
+    run(PoolBacking::TransparentHugePages);
+    run(PoolBacking::HugeTLB2M);
+    run(PoolBacking::HugeTLB1G);
+    restore_diagnostics();
+    return 0;
+}
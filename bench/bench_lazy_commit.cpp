@@ -0,0 +1,54 @@
+#include <cstdio>
+#include <vector>
+#include "fixAlloc.h"
+#include "benchUtil.h"
+
+/**
+ * Startup cost of a large pool: construction time and RSS right after
+ * construction, then after the first 1% of blocks are handed out and
+ * written. Eager pools memset the whole pool up front; lazy pools only
+ * reserve address space and commit it as the high-water mark grows.
+ */
+
+const size_t kBlockSize = 256;
+
+double rss_mb() {
+    return current_rss_bytes() / (1024.0 * 1024.0);
+}
+
+void run(const char* name, size_t pool_bytes, bool lazy) {
+    size_t num_blocks = pool_bytes / kBlockSize;
+    FixedAllocatorOptions options;
+    options.lazy_commit = lazy;
+    
+    double rss_before = rss_mb();
+    FixedAllocator* allocator = nullptr;
+    double ns = time_ns([&] {
+        allocator = new FixedAllocator(kBlockSize, num_blocks, options);
+    });
+    double rss_built = rss_mb() - rss_before;
+    
+    std::vector<void*> ptrs(num_blocks / 100);
+    for (auto& ptr : ptrs) {
+        ptr = allocator->allocate();
+        static_cast<char*>(ptr)[0] = 1;
+    }
+    double rss_used = rss_mb() - rss_before;
+    
+    std::printf("%-6s %6zu GB %14.2f %16.1f %16.1f %14.1f\n", name, pool_bytes >> 30,
+                ns / 1e6, rss_built, rss_used,
+                allocator->get_committed_bytes() / (1024.0 * 1024.0));
+    delete allocator;
+}
+
+int main() {
+    std::printf("%-6s %9s %14s %16s %16s %14s\n", "mode", "pool", "construct ms",
+                "RSS built (MB)", "RSS 1% used (MB)", "committed MB");
+    silence_diagnostics();
+    run("eager", size_t(2) << 30, false);
+    run("lazy", size_t(2) << 30, true);
+    // An eager 16 GB pool would not fit in memory on a small machine
+    run("lazy", size_t(16) << 30, true);
+    restore_diagnostics();
+    return 0;
+}
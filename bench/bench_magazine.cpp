@@ -0,0 +1,66 @@
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "concurrentAlloc.h"
+#include "magazineCache.h"
+#include "benchUtil.h"
+
+/**
+ * Multi-threaded allocate/free throughput with and without per-thread
+ * magazines in front of ConcurrentFixedAllocator, for several magazine
+ * sizes. Same workload as bench_concurrent.
+ */
+
+const size_t kWorkingSet = 32;
+const size_t kOpsPerThread = 200000;
+
+// Million allocate+free pairs per second across all threads
+template <typename Allocator>
+double throughput_mops(Allocator& allocator, size_t num_threads) {
+    double ns = time_ns([&] {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&] {
+                void* ptrs[kWorkingSet];
+                for (size_t done = 0; done < kOpsPerThread; done += kWorkingSet) {
+                    for (auto& ptr : ptrs) {
+                        ptr = allocator.allocate();
+                    }
+                    do_not_optimize(ptrs[0]);
+                    for (void* ptr : ptrs) {
+                        allocator.deallocate(ptr);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+    return (num_threads * kOpsPerThread) / ns * 1000.0;
+}
+
+int main() {
+    const size_t thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+    const size_t magazine_sizes[] = {16, 64, 256};
+    // Room for every thread's working set plus a full magazine each
+    const size_t num_blocks = 64 * (kWorkingSet + 256) * 2;
+
+    std::printf("hardware threads: %u\n\n", std::thread::hardware_concurrency());
+    std::printf("%8s %12s", "threads", "lock-free");
+    for (size_t size : magazine_sizes) {
+        std::printf("      mag=%-4zu", size);
+    }
+    std::printf("   (Mops/s)\n");
+
+    for (size_t num_threads : thread_counts) {
+        ConcurrentFixedAllocator lock_free(64, num_blocks);
+        std::printf("%8zu %12.2f", num_threads, throughput_mops(lock_free, num_threads));
+        for (size_t size : magazine_sizes) {
+            ThreadCachedAllocator cached(64, num_blocks, size);
+            std::printf(" %14.2f", throughput_mops(cached, num_threads));
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
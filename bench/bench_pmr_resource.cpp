@@ -0,0 +1,90 @@
+#include <cstdio>
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <vector>
+#include "poolResource.h"
+#include "benchUtil.h"
+
+/**
+ * FixedPoolResource against the standard pmr resources: raw 48-byte
+ * allocate/deallocate through memory_resource*, and insert+erase churn of
+ * a std::pmr::map holding kLive elements. Nanoseconds per operation pair.
+ */
+
+const size_t kLive = 100000;
+const size_t kOps = 2000000;
+const size_t kWorkingSet = 32;
+
+double raw_ns(std::pmr::memory_resource& resource) {
+    void* ptrs[kWorkingSet];
+    double ns = time_ns([&] {
+        for (size_t done = 0; done < kOps; done += kWorkingSet) {
+            for (auto& ptr : ptrs) {
+                ptr = resource.allocate(48, alignof(std::max_align_t));
+            }
+            do_not_optimize(ptrs[0]);
+            for (void* ptr : ptrs) {
+                resource.deallocate(ptr, 48, alignof(std::max_align_t));
+            }
+        }
+    });
+    return ns / kOps;
+}
+
+double map_churn_ns(std::pmr::memory_resource& resource) {
+    std::pmr::map<uint64_t, uint64_t> map(&resource);
+    std::mt19937_64 rng(7);
+    std::vector<uint64_t> keys(kLive);
+    for (auto& key : keys) {
+        key = rng();
+        map.emplace(key, key);
+    }
+    double ns = time_ns([&] {
+        for (size_t i = 0; i < kOps; ++i) {
+            size_t slot = rng() % kLive;
+            map.erase(keys[slot]);
+            keys[slot] = rng();
+            map.emplace(keys[slot], i);
+        }
+    });
+    do_not_optimize(map.size());
+    return ns / kOps;
+}
+
+void run(const char* name, std::pmr::memory_resource& resource) {
+    double raw = raw_ns(resource);
+    double churn = map_churn_ns(resource);
+    restore_diagnostics();
+    std::printf("%-26s %12.1f %16.1f\n", name, raw, churn);
+    silence_diagnostics();
+}
+
+int main() {
+    const size_t num_blocks = kLive * 2;
+    FixedAllocatorOptions free_list;
+    free_list.mode = AllocationMode::FreeList;
+    free_list.detect_double_free = false;
+    
+    std::printf("%-26s %12s %16s   (ns per allocate+free)\n", "resource", "raw 48 B", "pmr::map churn");
+    silence_diagnostics();
+    run("new_delete_resource", *std::pmr::new_delete_resource());
+    {
+        std::pmr::unsynchronized_pool_resource resource;
+        run("unsynchronized_pool", resource);
+    }
+    {
+        std::pmr::synchronized_pool_resource resource;
+        run("synchronized_pool", resource);
+    }
+    {
+        FixedPoolResource resource(64, num_blocks);
+        run("FixedPoolResource bitmap", resource);
+    }
+    {
+        FixedPoolResource resource(64, num_blocks, std::pmr::get_default_resource(), free_list);
+        run("FixedPoolResource freelist", resource);
+    }
+    restore_diagnostics();
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <cstdio>
+#include <list>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "poolAllocator.h"
+#include "benchUtil.h"
+
+/**
+ * Node container churn with std::allocator vs PoolAllocator: a map,
+ * an unordered_map and a list keep kLive elements while random keys are
+ * inserted and erased. Reports nanoseconds per insert+erase pair.
+ */
+
+const size_t kLive = 100000;
+const size_t kOps = 2000000;
+
+template <typename Map>
+double map_churn_ns(Map& map) {
+    std::mt19937_64 rng(7);
+    std::vector<uint64_t> keys(kLive);
+    for (auto& key : keys) {
+        key = rng();
+        map.emplace(key, key);
+    }
+    double ns = time_ns([&] {
+        for (size_t i = 0; i < kOps; ++i) {
+            size_t slot = rng() % kLive;
+            map.erase(keys[slot]);
+            keys[slot] = rng();
+            map.emplace(keys[slot], i);
+        }
+    });
+    do_not_optimize(map.size());
+    return ns / kOps;
+}
+
+template <typename List>
+double list_churn_ns(List& list) {
+    for (size_t i = 0; i < kLive; ++i) {
+        list.push_back(i);
+    }
+    double ns = time_ns([&] {
+        for (size_t i = 0; i < kOps; ++i) {
+            list.pop_front();
+            list.push_back(i);
+        }
+    });
+    do_not_optimize(list.size());
+    return ns / kOps;
+}
+
+template <typename K, typename V>
+using PoolMapAllocator = PoolAllocator<std::pair<const K, V>>;
+
+int main() {
+    std::printf("%-16s %16s %16s   (ns per insert+erase)\n", "container", "std::allocator", "PoolAllocator");
+    silence_diagnostics();
+    
+    double std_map, pool_map, std_hash, pool_hash, std_list, pool_list;
+    {
+        std::map<uint64_t, uint64_t> map;
+        std_map = map_churn_ns(map);
+    }
+    {
+        std::map<uint64_t, uint64_t, std::less<uint64_t>, PoolMapAllocator<uint64_t, uint64_t>> map;
+        pool_map = map_churn_ns(map);
+    }
+    {
+        std::unordered_map<uint64_t, uint64_t> map;
+        std_hash = map_churn_ns(map);
+    }
+    {
+        std::unordered_map<uint64_t, uint64_t, std::hash<uint64_t>, std::equal_to<uint64_t>,
+                           PoolMapAllocator<uint64_t, uint64_t>> map;
+        pool_hash = map_churn_ns(map);
+    }
+    {
+        std::list<uint64_t> list;
+        std_list = list_churn_ns(list);
+    }
+    {
+        std::list<uint64_t, PoolAllocator<uint64_t>> list;
+        pool_list = list_churn_ns(list);
+    }
+    
+    restore_diagnostics();
+    std::printf("%-16s %16.1f %16.1f\n", "std::map", std_map, pool_map);
+    std::printf("%-16s %16.1f %16.1f\n", "unordered_map", std_hash, pool_hash);
+    std::printf("%-16s %16.1f %16.1f\n", "std::list", std_list, pool_list);
+    return 0;
+}
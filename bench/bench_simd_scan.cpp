@@ -0,0 +1,42 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "bitScan.h"
+#include "benchUtil.h"
+
+/**
+ * Worst-case "first non-full word" scan: every word is full except the
+ * last. Runs each kernel the CPU supports over bitmaps sized for pools of
+ * 4K to 100M blocks.
+ */
+
+int main() {
+    const size_t word_counts[] = {64, 4096, 262144, 1562500};  // 4K, 256K, 16M, 100M blocks
+    const BitScanKernel kernels[] = {BitScanKernel::Scalar, BitScanKernel::AVX2, BitScanKernel::AVX512};
+
+    std::printf("Dispatched kernel: %s\n\n", bit_scan_kernel_name(active_bit_scan_kernel()));
+    std::printf("%12s %8s %14s %12s\n", "words", "kernel", "ns/scan", "words/ns");
+
+    for (size_t count : word_counts) {
+        std::vector<uint64_t> words(count, ~uint64_t(0));
+        words.back() = 0x7FFFFFFFFFFFFFFFull;
+        size_t iterations = std::max<size_t>(16, (size_t(1) << 26) / count);
+
+        for (BitScanKernel kernel : kernels) {
+            BitScanFn scan = get_bit_scan_kernel(kernel);
+            if (!scan) {
+                std::printf("%12zu %8s %14s\n", count, bit_scan_kernel_name(kernel), "unsupported");
+                continue;
+            }
+            double ns = time_ns([&] {
+                for (size_t i = 0; i < iterations; ++i) {
+                    size_t index = scan(words.data(), count, ~uint64_t(0));
+                    do_not_optimize(index);
+                }
+            }) / iterations;
+            std::printf("%12zu %8s %14.1f %12.2f\n", count, bit_scan_kernel_name(kernel), ns, count / ns);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <cstdio>
+#include "fixAlloc.h"
+#include "staticFixAlloc.h"
+#include "benchUtil.h"
+
+/**
+ * Runtime vs compile-time geometry for the same pool (48-byte blocks):
+ * allocate/free of a small working set, and is_valid_pointer() alone,
+ * where the runtime version divides by block_size_.
+ */
+
+const size_t kBlocks = 4096;
+const size_t kWorkingSet = 32;
+const size_t kOps = 20000000;
+
+FIXALLOC_CONSTINIT StaticFixedAllocator<48, kBlocks> g_static_pool;
+
+template <typename Allocator>
+double churn_ns(Allocator& allocator) {
+    void* ptrs[kWorkingSet];
+    double ns = time_ns([&] {
+        for (size_t done = 0; done < kOps; done += kWorkingSet) {
+            for (auto& ptr : ptrs) {
+                ptr = allocator.allocate();
+            }
+            do_not_optimize(ptrs[0]);
+            for (void* ptr : ptrs) {
+                allocator.deallocate(ptr);
+            }
+        }
+    });
+    return ns / kOps;
+}
+
+template <typename Allocator>
+double validate_ns(Allocator& allocator) {
+    void* ptr = allocator.allocate();
+    size_t valid = 0;
+    double ns = time_ns([&] {
+        for (size_t i = 0; i < kOps; ++i) {
+            do_not_optimize(ptr);
+            valid += allocator.is_valid_pointer(static_cast<char*>(ptr) + (i & 1) * 8);
+        }
+    });
+    do_not_optimize(valid);
+    allocator.deallocate(ptr);
+    return ns / kOps;
+}
+
+int main() {
+    std::printf("%-22s %16s %18s\n", "allocator", "alloc+free (ns)", "is_valid_ptr (ns)");
+    silence_diagnostics();
+    double runtime_churn, runtime_validate;
+    {
+        FixedAllocator allocator(48, kBlocks);
+        runtime_churn = churn_ns(allocator);
+        runtime_validate = validate_ns(allocator);
+    }
+    double static_churn = churn_ns(g_static_pool);
+    double static_validate = validate_ns(g_static_pool);
+    restore_diagnostics();
+    std::printf("%-22s %16.2f %18.2f\n", "FixedAllocator", runtime_churn, runtime_validate);
+    std::printf("%-22s %16.2f %18.2f\n", "StaticFixedAllocator", static_churn, static_validate);
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "tlsfAlloc.h"
+#include "benchUtil.h"
+
+/**
+ * Latency distribution of single allocations and frees, which is what a
+ * real-time budget cares about (the mean hides the outliers). A working
+ * set of kLive blocks of 16 B - 64 KB (log-uniform sizes) is churned: each
+ * step frees a random block and allocates a new one, and every call is
+ * timed on its own. Reports percentiles up to p99.99 and the maximum;
+ * every figure includes the cost of reading the clock (the "timer" row).
+ */
+
+const size_t kLive = 4096;
+const size_t kWarmupSteps = 200000;
+const size_t kSteps = 2000000;
+
+using Clock = std::chrono::steady_clock;
+
+struct Latencies {
+    std::vector<uint32_t> alloc_ns;
+    std::vector<uint32_t> free_ns;
+};
+
+template <typename Fn>
+inline uint32_t time_one(Fn&& fn) {
+    auto start = Clock::now();
+    fn();
+    auto end = Clock::now();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+void print_row(const char* name, const char* op, std::vector<uint32_t>& samples) {
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) { return samples[static_cast<size_t>(q * (samples.size() - 1))]; };
+    std::printf("%-9s %-6s %8u %8u %8u %9u %9u\n", name, op,
+                at(0.50), at(0.99), at(0.999), at(0.9999), samples.back());
+}
+
+int main() {
+    std::mt19937_64 rng(17);
+    std::vector<size_t> sizes(1 << 16);
+    for (auto& size : sizes) {
+        size_t shift = 4 + rng() % 12;  // 16 B .. 64 KB
+        size = (size_t(1) << shift) + rng() % (size_t(1) << shift);
+    }
+    std::vector<uint32_t> victims(kWarmupSteps + kSteps);
+    for (auto& victim : victims) {
+        victim = static_cast<uint32_t>(rng() % kLive);
+    }
+    
+    // alloc(size) returns a block, release(ptr) frees it
+    auto churn = [&](auto&& alloc, auto&& release) {
+        Latencies result;
+        result.alloc_ns.reserve(kSteps);
+        result.free_ns.reserve(kSteps);
+        std::vector<void*> live(kLive);
+        for (size_t i = 0; i < kLive; ++i) {
+            live[i] = alloc(sizes[i]);
+        }
+        for (size_t step = 0; step < kWarmupSteps + kSteps; ++step) {
+            void*& slot = live[victims[step]];
+            size_t size = sizes[step % sizes.size()];
+            if (step < kWarmupSteps) {
+                release(slot);
+                slot = alloc(size);
+                continue;
+            }
+            result.free_ns.push_back(time_one([&] { release(slot); }));
+            result.alloc_ns.push_back(time_one([&] { slot = alloc(size); }));
+            do_not_optimize(slot);
+        }
+        for (void* ptr : live) {
+            release(ptr);
+        }
+        return result;
+    };
+    
+    std::vector<uint32_t> timer_ns;
+    timer_ns.reserve(kSteps);
+    for (size_t i = 0; i < kSteps; ++i) {
+        timer_ns.push_back(time_one([] {}));
+    }
+    
+    Latencies malloc_lat = churn([](size_t size) { return std::malloc(size); },
+                                 [](void* ptr) { std::free(ptr); });
+    
+    TlsfAllocator tlsf(256 << 20);
+    size_t failed = 0;
+    Latencies tlsf_lat = churn([&](size_t size) {
+                                   void* ptr = tlsf.allocate(size);
+                                   failed += ptr == nullptr;
+                                   return ptr;
+                               },
+                               [&](void* ptr) {
+                                   if (ptr) {
+                                       tlsf.deallocate(ptr);
+                                   }
+                               });
+    
+    std::printf("%-9s %-6s %8s %8s %8s %9s %9s   (ns)\n", "allocator", "op", "p50", "p99", "p99.9", "p99.99", "max");
+    print_row("timer", "-", timer_ns);
+    print_row("malloc", "alloc", malloc_lat.alloc_ns);
+    print_row("malloc", "free", malloc_lat.free_ns);
+    print_row("tlsf", "alloc", tlsf_lat.alloc_ns);
+    print_row("tlsf", "free", tlsf_lat.free_ns);
+    if (failed) {
+        std::printf("(%zu tlsf allocations failed)\n", failed);
+    }
+    return 0;
+}
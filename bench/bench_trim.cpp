@@ -0,0 +1,67 @@
+#include <cstdio>
+#include <vector>
+#include "fixAlloc.h"
+#include "growableAlloc.h"
+#include "benchUtil.h"
+
+/**
+ * RSS across a traffic spike: allocate and touch a large working set, free
+ * most of it, then trim. Shows RSS dropping back without destroying the
+ * allocator, for a fixed pool and for a growable slab pool.
+ */
+
+const size_t kBlockSize = 256;
+const size_t kBlocks = 1 << 20;  // 256 MB at peak
+
+void print_rss(const char* phase) {
+    std::printf("  %-34s %8.1f MB\n", phase, current_rss_bytes() / (1024.0 * 1024.0));
+}
+
+template <typename Allocator>
+void run_spike(Allocator& allocator) {
+    print_rss("after construction");
+
+    std::vector<void*> ptrs(kBlocks);
+    for (auto& ptr : ptrs) {
+        ptr = allocator.allocate();
+        static_cast<char*>(ptr)[0] = 1;
+    }
+    print_rss("at peak (all blocks live)");
+
+    // Off-peak: keep every 64th block alive, scattered through the pool
+    for (size_t i = 0; i < kBlocks; ++i) {
+        if (i % 64 != 0) {
+            allocator.deallocate(ptrs[i]);
+        }
+    }
+    print_rss("after freeing 63/64 of blocks");
+
+    double ns = time_ns([&] {
+        size_t released = allocator.trim();
+        std::printf("  trim() released %.1f MB", released / (1024.0 * 1024.0));
+    });
+    std::printf(" in %.2f ms\n", ns / 1e6);
+    print_rss("after trim()");
+
+    for (size_t i = 0; i < kBlocks; i += 64) {
+        allocator.deallocate(ptrs[i]);
+    }
+    allocator.trim();
+    print_rss("after freeing everything + trim()");
+}
+
+int main() {
+    silence_diagnostics();
+    {
+        FixedAllocator allocator(kBlockSize, kBlocks);
+        std::printf("FixedAllocator (%zu x %zu bytes)\n", kBlocks, kBlockSize);
+        run_spike(allocator);
+    }
+    {
+        GrowableFixedAllocator allocator(kBlockSize, kBlocks / 64);
+        std::printf("\nGrowableFixedAllocator (slabs of %zu blocks)\n", kBlocks / 64);
+        run_spike(allocator);
+    }
+    restore_diagnostics();
+    return 0;
+}
@@ -3,6 +3,27 @@
 #include <vector>         // For storing pointers in tests
 #include <cstdlib>        // For malloc/free
 #include "fixAlloc.h"     // Our custom fixed allocator
+#include "allocDiagnostics.h" // flush_diagnostics() keeps messages next to their test
+#include "sizeClassAlloc.h" // Multi-pool allocator for variable sizes
+#include "numaAlloc.h"      // Per-NUMA-node pools
+#include "poolAllocator.h"  // Standard Allocator over growable pools
+#include "growableAlloc.h"  // Pools that chain slabs
+#include <list>           // Containers for the PoolAllocator test
+#include <map>
+#include "staticFixAlloc.h" // Compile-time pool geometry
+#include "objectPool.h"     // Typed pools with pooled_ptr
+#include "stackAlloc.h"     // LIFO scratch allocator
+#include "tlsfAlloc.h"      // Bounded-latency variable-size allocator
+#include "buddyAlloc.h"      // Power-of-two buddy blocks
+#include "arenaAlloc.h"      // Monotonic bump allocator
+#include "poolResource.h"    // std::pmr resource over a pool
+#include "concurrentAlloc.h" // Lock-free shared pools
+#include "magazineCache.h" // Per-thread caches over a shared pool
+#include <algorithm>      // Sorting pointers in the multi-threaded tests
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <stdexcept>      // Throwing constructor in the object pool test
 
 /**
  * Test basic allocator functionality
@@ -69,6 +90,8 @@ void test_basic_allocator() {
         // Catch any errors during allocator construction or testing
         std::cerr << "Error in basic allocator test: " << e.what() << std::endl;
     }
+    
+    flush_diagnostics();
 }
 
 /**
@@ -144,6 +167,8 @@ void test_allocator_limits() {
     } catch (const std::exception& e) {
         std::cerr << "Error in limits test: " << e.what() << std::endl;
     }
+    
+    flush_diagnostics();
 }
 
 /**
@@ -175,6 +200,954 @@ void test_error_handling() {
     } catch (const std::exception& e) {
         std::cerr << "Error in error handling test: " << e.what() << std::endl;
     }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test the intrusive free-list allocation mode
+ * This function tests:
+ * 1. LIFO reuse of the most recently freed block
+ * 2. Double-free detection through the side bitmap
+ */
+void test_free_list_mode() {
+    std::cout << "\n=== Testing Free-List Mode ===" << std::endl;
+    
+    try {
+        FixedAllocatorOptions options;
+        options.mode = AllocationMode::FreeList;
+        FixedAllocator allocator(32, 4, options);
+        
+        void* ptr1 = allocator.allocate();
+        void* ptr2 = allocator.allocate();
+        std::cout << "Allocated: " << ptr1 << ", " << ptr2 << std::endl;
+        
+        // The freed block is on top of the free list, so it comes back first
+        allocator.deallocate(ptr1);
+        void* ptr3 = allocator.allocate();
+        std::cout << "Reallocated freed block: " << (ptr3 == ptr1 ? "YES" : "NO") << std::endl;
+        
+        bool first_free = allocator.deallocate(ptr2);
+        bool second_free = allocator.deallocate(ptr2);
+        std::cout << "First deallocation: " << (first_free ? "SUCCESS" : "FAILED") << std::endl;
+        std::cout << "Second deallocation (should fail): " << (second_free ? "SUCCESS" : "FAILED") << std::endl;
+        
+        allocator.deallocate(ptr3);
+        std::cout << "Pool is empty: " << (allocator.is_empty() ? "YES" : "NO") << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in free-list test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test the summary levels over a large bitmap (more than 64 words)
+ * This function tests:
+ * 1. Filling a pool of 20000 blocks through the summary search
+ * 2. Freeing scattered blocks far apart in the bitmap
+ * 3. allocate() returning the lowest freed address first
+ */
+void test_summary_levels() {
+    std::cout << "\n=== Testing Summary Levels ===" << std::endl;
+    
+    try {
+        FixedAllocator allocator(16, 20000);
+        std::vector<void*> ptrs;
+        while (void* ptr = allocator.allocate()) {
+            ptrs.push_back(ptr);
+        }
+        std::cout << "Filled pool: " << ptrs.size() << " blocks, free: "
+                  << allocator.get_free_blocks() << std::endl;
+        
+        // Freed out of order; they must come back in address order
+        const size_t freed[] = {19000, 7000, 12345, 4100};
+        for (size_t index : freed) {
+            allocator.deallocate(ptrs[index]);
+        }
+        const size_t expected[] = {4100, 7000, 12345, 19000};
+        bool in_order = true;
+        for (size_t index : expected) {
+            in_order = in_order && allocator.allocate() == ptrs[index];
+        }
+        std::cout << "Freed blocks reused lowest address first: " << (in_order ? "YES" : "NO") << std::endl;
+        std::cout << "Pool full again: " << (allocator.is_full() ? "YES" : "NO") << std::endl;
+        
+        for (void* ptr : ptrs) {
+            allocator.deallocate(ptr);
+        }
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in summary level test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test the next-fit search policy
+ * This function tests:
+ * 1. Resuming after the last handed-out block instead of reusing a lower one
+ * 2. Wrapping to the start of the pool once the end is reached
+ */
+void test_next_fit() {
+    std::cout << "\n=== Testing Next Fit ===" << std::endl;
+    
+    try {
+        FixedAllocatorOptions options;
+        options.fit = FitPolicy::NextFit;
+        FixedAllocator allocator(32, 8, options);
+        
+        std::vector<void*> ptrs;
+        for (int i = 0; i < 5; ++i) {
+            ptrs.push_back(allocator.allocate());
+        }
+        
+        // Block 1 is free again, but next fit carries on from block 5
+        allocator.deallocate(ptrs[1]);
+        void* next = allocator.allocate();
+        std::cout << "After freeing block 1, next fit returned block "
+                  << (static_cast<char*>(next) - static_cast<char*>(ptrs[0])) / 32
+                  << " (expected 5)" << std::endl;
+        
+        // Blocks 6 and 7 use up the tail; the following search wraps around
+        void* b6 = allocator.allocate();
+        void* b7 = allocator.allocate();
+        void* wrapped = allocator.allocate();
+        std::cout << "Wrapped to the freed block 1: " << (wrapped == ptrs[1] ? "YES" : "NO") << std::endl;
+        
+        for (void* ptr : {ptrs[0], wrapped, ptrs[2], ptrs[3], ptrs[4], next, b6, b7}) {
+            allocator.deallocate(ptr);
+        }
+        std::cout << "Pool is empty: " << (allocator.is_empty() ? "YES" : "NO") << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in next fit test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test the batch allocation API
+ * This function tests:
+ * 1. A batch spanning several bitmap words
+ * 2. A partial batch when the pool runs out
+ * 3. deallocate_bulk() skipping an invalid pointer and a double free
+ */
+void test_bulk_operations() {
+    std::cout << "\n=== Testing Bulk Operations ===" << std::endl;
+    
+    try {
+        FixedAllocator allocator(16, 100);
+        
+        // 70 blocks cross the boundary between bitmap words 0 and 1
+        std::vector<void*> first(70);
+        size_t got = allocator.allocate_bulk(first.data(), first.size());
+        bool contiguous = true;
+        for (size_t i = 1; i < got; ++i) {
+            contiguous = contiguous
+                && static_cast<char*>(first[i]) == static_cast<char*>(first[i - 1]) + 16;
+        }
+        std::cout << "Batch of 70: got " << got
+                  << ", consecutive blocks: " << (contiguous ? "YES" : "NO") << std::endl;
+        
+        // Only 30 blocks are left
+        std::vector<void*> second(50);
+        size_t partial = allocator.allocate_bulk(second.data(), second.size());
+        std::cout << "Batch of 50 from 30 free blocks: got " << partial << std::endl;
+        
+        // 10 valid pointers, one foreign pointer, and one of the 10 repeated
+        int foreign = 0;
+        std::vector<void*> batch(second.begin(), second.begin() + 10);
+        batch.push_back(&foreign);
+        batch.push_back(second[3]);
+        size_t freed = allocator.deallocate_bulk(batch.data(), batch.size());
+        std::cout << "deallocate_bulk of 12 pointers (10 valid): freed " << freed
+                  << ", free blocks: " << allocator.get_free_blocks() << std::endl;
+        
+        allocator.deallocate_bulk(first.data(), got);
+        allocator.deallocate_bulk(second.data() + 10, partial - 10);
+        std::cout << "Pool is empty: " << (allocator.is_empty() ? "YES" : "NO") << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in bulk test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Run 4 threads against one shared pool. Each thread repeatedly takes 64
+ * blocks, stamps them, checks no other thread overwrote a stamp, and frees
+ * them; the last batch is kept so the caller can check the blocks are all
+ * distinct. Returns false if a stamp was overwritten or a block handed out
+ * twice, and leaves every block free.
+ */
+bool stress_shared_pool(ConcurrentFixedAllocator& pool) {
+    const size_t kThreads = 4;
+    const size_t kBatch = 64;
+    std::atomic<bool> stamps_ok{true};
+    std::vector<std::vector<void*>> held(kThreads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (uint64_t round = 0; round < 200; ++round) {
+                held[t].clear();
+                for (uint64_t i = 0; i < kBatch; ++i) {
+                    if (auto* block = static_cast<uint64_t*>(pool.allocate())) {
+                        *block = (t << 32) | (round << 16) | i;
+                        held[t].push_back(block);
+                    }
+                }
+                for (uint64_t i = 0; i < held[t].size(); ++i) {
+                    if (*static_cast<uint64_t*>(held[t][i]) != ((t << 32) | (round << 16) | i)) {
+                        stamps_ok = false;
+                    }
+                }
+                if (round + 1 < 200) {
+                    for (void* block : held[t]) {
+                        pool.deallocate(block);
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    std::vector<void*> all;
+    for (auto& blocks : held) {
+        all.insert(all.end(), blocks.begin(), blocks.end());
+    }
+    std::sort(all.begin(), all.end());
+    bool unique = std::adjacent_find(all.begin(), all.end()) == all.end();
+    for (void* block : all) {
+        pool.deallocate(block);
+    }
+    return stamps_ok && unique && all.size() == kThreads * kBatch;
+}
+
+/**
+ * Test the lock-free ConcurrentFixedAllocator from several threads
+ * This function tests:
+ * 1. Blocks handed out concurrently are distinct and never overwritten
+ * 2. Every block is free again once the threads are done
+ * 3. The same in free-list mode (lock-free Treiber stack)
+ */
+void test_concurrent_allocator() {
+    std::cout << "\n=== Testing Concurrent Allocator ===" << std::endl;
+    
+    try {
+        ConcurrentFixedAllocator bitmap_pool(64, 512);
+        bool ok = stress_shared_pool(bitmap_pool);
+        std::cout << "Bitmap mode, 4 threads: " << (ok ? "blocks unique" : "OVERLAP")
+                  << ", free blocks: " << bitmap_pool.get_free_blocks()
+                  << "/" << bitmap_pool.get_total_blocks() << std::endl;
+        
+        // Treiber-stack free list, with and without the double-free bitmap
+        for (bool detect : {true, false}) {
+            FixedAllocatorOptions options;
+            options.mode = AllocationMode::FreeList;
+            options.detect_double_free = detect;
+            ConcurrentFixedAllocator list_pool(64, 512, options);
+            ok = stress_shared_pool(list_pool);
+            std::cout << "Free-list mode" << (detect ? " (double-free checks)" : "") << ", 4 threads: "
+                      << (ok ? "blocks unique" : "OVERLAP") << ", free blocks: "
+                      << list_pool.get_free_blocks() << "/" << list_pool.get_total_blocks() << std::endl;
+        }
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in concurrent test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test ThreadCachedAllocator's per-thread magazines
+ * This function tests:
+ * 1. Blocks handed out from several threads' magazines are distinct
+ * 2. A thread's cached blocks go back to the central pool when it exits
+ * 3. flush_thread_cache() on the calling thread
+ */
+void test_magazine_cache() {
+    std::cout << "\n=== Testing Magazine Cache ===" << std::endl;
+    
+    try {
+        ThreadCachedAllocator allocator(64, 1024, 32);
+        std::vector<std::vector<void*>> kept(4);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < kept.size(); ++t) {
+            threads.emplace_back([&allocator, &kept, t] {
+                // Churn through the magazine, then keep 50 blocks and free the rest
+                for (int round = 0; round < 100; ++round) {
+                    void* blocks[40];
+                    for (void*& block : blocks) {
+                        block = allocator.allocate();
+                    }
+                    for (void* block : blocks) {
+                        allocator.deallocate(block);
+                    }
+                }
+                for (int i = 0; i < 50; ++i) {
+                    kept[t].push_back(allocator.allocate());
+                }
+                for (int i = 0; i < 10; ++i) {
+                    allocator.deallocate(kept[t].back());
+                    kept[t].pop_back();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        
+        std::vector<void*> all;
+        for (auto& blocks : kept) {
+            all.insert(all.end(), blocks.begin(), blocks.end());
+        }
+        std::sort(all.begin(), all.end());
+        bool unique = std::adjacent_find(all.begin(), all.end()) == all.end()
+                   && std::find(all.begin(), all.end(), nullptr) == all.end();
+        std::cout << "Blocks kept by 4 threads: " << all.size()
+                  << ", unique: " << (unique ? "YES" : "NO") << std::endl;
+        
+        // The exited threads' magazines were drained: only kept blocks are out
+        std::cout << "Central free blocks after the threads exited: "
+                  << allocator.get_central_free_blocks()
+                  << " (expected " << allocator.get_total_blocks() - all.size() << ")" << std::endl;
+        
+        for (void* block : all) {
+            allocator.deallocate(block);
+        }
+        std::cout << "Cached by this thread: " << allocator.get_thread_cached_blocks() << std::endl;
+        allocator.flush_thread_cache();
+        std::cout << "Central free blocks after flush: " << allocator.get_central_free_blocks()
+                  << "/" << allocator.get_total_blocks() << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in magazine test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test the size-class allocator built on FixedAllocator pools
+ * This function tests:
+ * 1. Mapping request sizes to size classes
+ * 2. Internal fragmentation reporting per class
+ */
+void test_size_classes() {
+    std::cout << "\n=== Testing Size Classes ===" << std::endl;
+    
+    try {
+        SizeClassConfig config;
+        config.class_sizes = {16, 32, 64, 128};
+        config.bytes_per_class = 4096;
+        SizeClassAllocator allocator(config);
+        
+        // 20 and 24 bytes both land in the 32-byte class, 100 in the 128-byte class
+        void* a = allocator.allocate(20);
+        void* b = allocator.allocate(24);
+        void* c = allocator.allocate(100);
+        void* too_big = allocator.allocate(4096);
+        std::cout << "Class for 20 bytes: " << allocator.class_size_for(20) << std::endl;
+        std::cout << "Class for 100 bytes: " << allocator.class_size_for(100) << std::endl;
+        std::cout << "Oversized request returned: " << too_big << std::endl;
+        
+        std::cout << "\nPer-class usage:" << std::endl;
+        allocator.print_stats(std::cout);
+        
+        allocator.deallocate(a, 20);
+        allocator.deallocate(b, 24);
+        allocator.deallocate(c, 100);
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in size class test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test the growable allocator
+ * This function tests:
+ * 1. Adding slabs once the existing ones are full
+ * 2. Failing cleanly at max_slabs
+ * 3. Freeing blocks that live in different slabs
+ */
+void test_growable_allocator() {
+    std::cout << "\n=== Testing Growable Allocator ===" << std::endl;
+    
+    try {
+        // 4 blocks per slab, at most 3 slabs
+        GrowableFixedAllocator allocator(64, 4, 3);
+        std::cout << "Slabs after creation: " << allocator.get_num_slabs() << std::endl;
+        
+        std::vector<void*> ptrs;
+        while (void* ptr = allocator.allocate()) {
+            ptrs.push_back(ptr);
+        }
+        std::cout << "Allocated " << ptrs.size() << " blocks in "
+                  << allocator.get_num_slabs() << " slabs (expected 12 in 3)" << std::endl;
+        
+        // A freed block in the first slab is found again after growth
+        bool freed = allocator.deallocate(ptrs[1]);
+        void* again = allocator.allocate();
+        std::cout << "Block in first slab freed and reused: "
+                  << (freed && again == ptrs[1] ? "YES" : "NO") << std::endl;
+        
+        bool all_freed = true;
+        for (void* ptr : ptrs) {
+            all_freed = allocator.deallocate(ptr) && all_freed;
+        }
+        std::cout << "Freed blocks from every slab: " << (all_freed ? "SUCCESS" : "FAILED") << std::endl;
+        std::cout << "Pool is empty: " << (allocator.is_empty() ? "YES" : "NO") << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in growable allocator test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test returning free pages to the OS
+ * This function tests:
+ * 1. trim() releasing the pages of freed page-sized blocks
+ * 2. A trimmed block reading back as zero (Linux only)
+ * 3. The growable allocator keeping one empty slab
+ */
+void test_trim() {
+    std::cout << "\n=== Testing Trim ===" << std::endl;
+    
+    try {
+        // Page-sized, page-aligned blocks so each free block owns its page
+        FixedAllocatorOptions options;
+        options.alignment = 4096;
+        FixedAllocator allocator(4096, 8, options);
+        
+        std::vector<unsigned char*> ptrs;
+        while (void* ptr = allocator.allocate()) {
+            ptrs.push_back(static_cast<unsigned char*>(ptr));
+            std::fill_n(ptrs.back(), 4096, 0xAB);
+        }
+        std::cout << "Trim with every block live released: " << allocator.trim() << " bytes" << std::endl;
+        
+        allocator.deallocate(ptrs[3]);
+        size_t released = allocator.trim();
+        std::cout << "Trim after one free released: " << released << " bytes ("
+                  << (released != 0 ? "SUCCESS" : "FAILED") << ")" << std::endl;
+        
+        unsigned char* reused = static_cast<unsigned char*>(allocator.allocate());
+        std::cout << "Trimmed block reused: " << (reused == ptrs[3] ? "YES" : "NO") << std::endl;
+#ifdef __linux__
+        bool zeroed = std::all_of(reused, reused + 4096, [](unsigned char b) { return b == 0; });
+        std::cout << "Trimmed block reads back as zero: " << (zeroed ? "YES" : "NO") << std::endl;
+#endif
+        for (unsigned char* ptr : ptrs) {
+            allocator.deallocate(ptr);
+        }
+        
+        // Three slabs emptied: trim() keeps one of them
+        GrowableFixedAllocator growable(4096, 4, 0, options);
+        std::vector<void*> blocks;
+        for (int i = 0; i < 12; ++i) {
+            blocks.push_back(growable.allocate());
+        }
+        for (void* ptr : blocks) {
+            growable.deallocate(ptr);
+        }
+        std::cout << "Slabs before trim: " << growable.get_num_slabs() << std::endl;
+        growable.trim();
+        std::cout << "Slabs after trim: " << growable.get_num_slabs() << " (expected 1)" << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in trim test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test lazily committed pools
+ * This function tests:
+ * 1. Nothing committed before the first allocation
+ * 2. get_committed_bytes() growing as higher blocks are handed out
+ * 3. Never committing more than the pool
+ */
+void test_lazy_commit() {
+    std::cout << "\n=== Testing Lazy Commit ===" << std::endl;
+    
+    try {
+        // 8 MiB pool; commits happen in 2 MiB steps
+        FixedAllocatorOptions options;
+        options.lazy_commit = true;
+        FixedAllocator allocator(4096, 2048, options);
+        size_t initial = allocator.get_committed_bytes();
+        std::cout << "Committed after creation: " << initial << " bytes" << std::endl;
+        
+        std::vector<void*> ptrs;
+        ptrs.push_back(allocator.allocate());
+        size_t after_first = allocator.get_committed_bytes();
+        std::cout << "Committed after first block: " << after_first << " bytes" << std::endl;
+        
+        // Reach past the first commit step
+        while (ptrs.size() < 1024) {
+            ptrs.push_back(allocator.allocate());
+        }
+        size_t after_half = allocator.get_committed_bytes();
+        std::cout << "Committed after 1024 blocks: " << after_half << " bytes" << std::endl;
+        std::cout << "Commit grew with use: "
+                  << (initial < after_first && after_first < after_half ? "YES" : "NO") << std::endl;
+        std::cout << "Within the pool size: "
+                  << (after_half <= allocator.get_pool_size() ? "YES" : "NO") << std::endl;
+        
+        for (void* ptr : ptrs) {
+            allocator.deallocate(ptr);
+        }
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in lazy commit test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test block alignment options
+ * This function tests:
+ * 1. A 256-byte alignment on an odd block size
+ * 2. cache_line_isolate giving every block its own cache line
+ * 3. Every pointer being a multiple of get_alignment()
+ */
+void test_alignment() {
+    std::cout << "\n=== Testing Alignment ===" << std::endl;
+    
+    try {
+        FixedAllocatorOptions aligned;
+        aligned.alignment = 256;
+        FixedAllocator wide(40, 16, aligned);
+        
+        FixedAllocatorOptions isolated;
+        isolated.cache_line_isolate = true;
+        FixedAllocator padded(24, 16, isolated);
+        
+        for (FixedAllocator* allocator : {&wide, &padded}) {
+            std::vector<void*> ptrs;
+            bool all_aligned = true;
+            while (void* ptr = allocator->allocate()) {
+                ptrs.push_back(ptr);
+                all_aligned = all_aligned
+                              && reinterpret_cast<uintptr_t>(ptr) % allocator->get_alignment() == 0;
+            }
+            std::cout << "Alignment " << allocator->get_alignment() << ", block size "
+                      << allocator->get_block_size() << ": all " << ptrs.size()
+                      << " blocks aligned: " << (all_aligned ? "YES" : "NO") << std::endl;
+            for (void* ptr : ptrs) {
+                allocator->deallocate(ptr);
+            }
+        }
+        std::cout << "Isolated blocks use a whole cache line: "
+                  << (padded.get_block_size() % kCacheLineSize == 0 ? "YES" : "NO") << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in alignment test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test the NUMA-aware allocator (one pool on single-node machines)
+ * This function tests:
+ * 1. Allocation and the node that owns a block
+ * 2. Spill-over to other nodes, then nullptr once every pool is full
+ * 3. Deallocation back to the owning pool
+ */
+void test_numa_allocator() {
+    std::cout << "\n=== Testing NUMA Allocator ===" << std::endl;
+    
+    try {
+        NumaFixedAllocator allocator(64, 4);
+        std::cout << "Nodes: " << allocator.get_num_nodes()
+                  << ", current node: " << NumaFixedAllocator::current_node() << std::endl;
+        
+        void* ptr = allocator.allocate();
+        std::cout << "Block " << ptr << " is on node " << allocator.node_of(ptr) << std::endl;
+        
+        // Fill every node's pool: the local one first, then the others
+        std::vector<void*> blocks = {ptr};
+        while (void* next = allocator.allocate()) {
+            blocks.push_back(next);
+        }
+        std::cout << "Blocks before exhaustion: " << blocks.size()
+                  << " (total: " << allocator.get_total_blocks() << ")" << std::endl;
+        
+        allocator.deallocate(blocks.back());
+        void* again = allocator.allocate();
+        std::cout << "Allocation after one free: " << (again ? "SUCCESS" : "FAILED") << std::endl;
+        blocks.back() = again;
+        
+        for (void* block : blocks) {
+            allocator.deallocate(block);
+        }
+        std::cout << "Free blocks after freeing all: " << allocator.get_free_blocks() << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in NUMA test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test PoolAllocator with standard containers
+ * This function tests:
+ * 1. Nodes of a std::list and a std::map coming from the shared pools
+ * 2. Using a container again after moving from it
+ * 3. Move assignment between containers with different pools
+ */
+void test_pool_allocator() {
+    std::cout << "\n=== Testing Pool Allocator ===" << std::endl;
+    
+    try {
+        std::list<int, PoolAllocator<int>> source;
+        source.push_back(1);
+        source.push_back(2);
+        
+        // The moved-from list keeps a working allocator that shares the pools
+        std::list<int, PoolAllocator<int>> moved(std::move(source));
+        source.push_back(3);
+        std::cout << "Moved list size: " << moved.size()
+                  << ", reused source size: " << source.size() << std::endl;
+        std::cout << "Allocators still equal: "
+                  << (source.get_allocator() == moved.get_allocator() ? "YES" : "NO") << std::endl;
+        
+        std::map<int, int, std::less<int>, PoolAllocator<std::pair<const int, int>>> first;
+        std::map<int, int, std::less<int>, PoolAllocator<std::pair<const int, int>>> second;
+        first[1] = 10;
+        second = std::move(first);
+        first[2] = 20;
+        std::cout << "Map sizes after move assignment: " << first.size() << ", " << second.size()
+                  << " (pools in use: " << second.get_allocator().get_pools()->get_num_pools() << ")" << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in pool allocator test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test the pmr memory resource
+ * This function tests:
+ * 1. Small requests served from the pool
+ * 2. Oversize, over-aligned and pool-full requests going upstream
+ * 3. Deallocation routed back to where each block came from
+ */
+void test_pool_resource() {
+    std::cout << "\n=== Testing Pool Resource ===" << std::endl;
+    
+    try {
+        FixedPoolResource resource(64, 2);
+        void* small = resource.allocate(32, 8);
+        std::cout << "Small request from the pool: "
+                  << (resource.get_pool().get_used_blocks() == 1 ? "YES" : "NO") << std::endl;
+        
+        void* oversize = resource.allocate(200, 8);
+        std::cout << "Oversize request went upstream: "
+                  << (resource.get_upstream_allocations() == 1 ? "YES" : "NO") << std::endl;
+        
+        void* over_aligned = resource.allocate(32, 256);
+        std::cout << "Over-aligned request went upstream: "
+                  << (resource.get_upstream_allocations() == 2
+                      && reinterpret_cast<uintptr_t>(over_aligned) % 256 == 0 ? "YES" : "NO") << std::endl;
+        
+        void* last = resource.allocate(64, 8);
+        void* overflow = resource.allocate(64, 8);
+        bool full = resource.get_pool().is_full();
+        std::cout << "Request after the pool filled went upstream: "
+                  << (full && resource.get_upstream_allocations() == 3 ? "YES" : "NO") << std::endl;
+        
+        resource.deallocate(small, 32, 8);
+        resource.deallocate(oversize, 200, 8);
+        resource.deallocate(over_aligned, 32, 256);
+        resource.deallocate(last, 64, 8);
+        resource.deallocate(overflow, 64, 8);
+        std::cout << "Pool blocks returned: "
+                  << (resource.get_pool().is_empty() ? "SUCCESS" : "FAILED") << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in pool resource test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+// Constant-initialized: usable even from other globals' constructors.
+// FIXALLOC_CONSTINIT only enforces that under C++20 or Clang; with GCC in
+// C++17 it is empty, so check here that the constructor is a constant
+// expression, which is what constant initialization relies on.
+static_assert((StaticFixedAllocator<24, 100>(), true),
+              "StaticFixedAllocator must be constexpr-constructible");
+FIXALLOC_CONSTINIT StaticFixedAllocator<24, 100> g_static_pool;
+
+/**
+ * Test the compile-time StaticFixedAllocator through a global pool
+ * This function tests:
+ * 1. Block size and count fixed by the template arguments
+ * 2. Allocation of adjacent blocks
+ * 3. Deallocation back to an empty pool
+ */
+void test_static_allocator() {
+    std::cout << "\n=== Testing Static Allocator ===" << std::endl;
+    
+    std::cout << "Block size: " << g_static_pool.get_block_size()
+              << ", blocks: " << g_static_pool.get_total_blocks() << std::endl;
+    void* a = g_static_pool.allocate();
+    void* b = g_static_pool.allocate();
+    std::cout << "Blocks are " << (static_cast<char*>(b) - static_cast<char*>(a))
+              << " bytes apart, used: " << g_static_pool.get_used_blocks() << std::endl;
+    g_static_pool.deallocate(a);
+    g_static_pool.deallocate(b);
+    std::cout << "Empty after freeing: " << (g_static_pool.is_empty() ? "true" : "false") << std::endl;
+    
+    flush_diagnostics();
+}
+
+// Counts live instances so the object pool test can see destructors run
+struct PooledWidget {
+    static int live;
+    int id;
+    
+    explicit PooledWidget(int widget_id) : id(widget_id) {
+        if (widget_id < 0) {
+            throw std::runtime_error("negative id");
+        }
+        ++live;
+    }
+    ~PooledWidget() { --live; }
+};
+
+int PooledWidget::live = 0;
+
+struct alignas(64) CacheLineCounter {
+    long value = 0;
+};
+
+/**
+ * Test the typed ObjectPool and pooled_ptr
+ * This function tests:
+ * 1. emplace() and destruction through pooled_ptr::reset
+ * 2. Alignment of an over-aligned type
+ * 3. A throwing constructor giving its block back
+ * 4. A full pool returning an empty pooled_ptr
+ */
+void test_object_pool() {
+    std::cout << "\n=== Testing Object Pool ===" << std::endl;
+    
+    try {
+        ObjectPool<PooledWidget> widgets(2);
+        pooled_ptr<PooledWidget> first = widgets.emplace(1);
+        std::cout << "Emplaced widget " << first->id << ", live: " << PooledWidget::live << std::endl;
+        first.reset();
+        std::cout << "After reset, live: " << PooledWidget::live
+                  << ", pool objects: " << widgets.get_live_objects() << std::endl;
+        
+        try {
+            widgets.emplace(-1);
+        } catch (const std::runtime_error& e) {
+            std::cout << "Constructor threw (" << e.what() << "), pool objects: "
+                      << widgets.get_live_objects() << std::endl;
+        }
+        
+        pooled_ptr<PooledWidget> a = widgets.emplace(2);
+        pooled_ptr<PooledWidget> b = widgets.emplace(3);
+        pooled_ptr<PooledWidget> overflow = widgets.emplace(4);
+        std::cout << "Emplace into full pool: " << (overflow ? "SUCCESS" : "EMPTY") << std::endl;
+        
+        ObjectPool<CacheLineCounter> counters(4);
+        pooled_ptr<CacheLineCounter> c1 = counters.emplace();
+        pooled_ptr<CacheLineCounter> c2 = counters.emplace();
+        bool aligned = reinterpret_cast<uintptr_t>(c1.get()) % 64 == 0
+                    && reinterpret_cast<uintptr_t>(c2.get()) % 64 == 0;
+        std::cout << "alignas(64) objects aligned: " << (aligned ? "YES" : "NO") << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in object pool test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test the monotonic arena
+ * This function tests:
+ * 1. Requested alignments being honoured
+ * 2. Chaining a new chunk when the current one is full
+ * 3. reset() reusing the same chunks instead of adding more
+ */
+void test_arena_allocator() {
+    std::cout << "\n=== Testing Arena Allocator ===" << std::endl;
+    
+    try {
+        ArenaAllocator arena(1024);
+        void* first = arena.allocate(10, 1);
+        void* aligned = arena.allocate(8, 64);
+        std::cout << "64-byte alignment honoured: "
+                  << (reinterpret_cast<uintptr_t>(aligned) % 64 == 0 ? "YES" : "NO") << std::endl;
+        
+        // 3 x 400 bytes don't fit in one 1 KiB chunk
+        for (int i = 0; i < 3; ++i) {
+            arena.allocate(400);
+        }
+        size_t chunks = arena.get_num_chunks();
+        std::cout << "Chunks after overflowing the first: " << chunks
+                  << ", allocated: " << arena.get_allocated_bytes() << " bytes" << std::endl;
+        
+        arena.reset();
+        void* again = arena.allocate(10, 1);
+        for (int i = 0; i < 3; ++i) {
+            arena.allocate(400);
+        }
+        std::cout << "Reset reuses the first chunk: " << (again == first ? "YES" : "NO") << std::endl;
+        std::cout << "No chunks added after reset: "
+                  << (arena.get_num_chunks() == chunks ? "YES" : "NO") << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in arena test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test the LIFO StackAllocator
+ * This function tests:
+ * 1. Bump allocation with a custom alignment
+ * 2. Rejection of an out-of-order free when LIFO checks are on
+ * 3. Rewinding to a marker and the peak usage it leaves behind
+ * 4. Freeing a zero-size block at the top of the stack
+ */
+void test_stack_allocator() {
+    std::cout << "\n=== Testing Stack Allocator ===" << std::endl;
+    
+    StackAllocator scratch(64 * 1024);
+    auto mark = scratch.marker();
+    void* a = scratch.allocate(100);
+    void* b = scratch.allocate(40, 64);
+    std::cout << "Used after two allocations: " << scratch.get_used_bytes() << " bytes" << std::endl;
+    
+    // Out of order: rejected when LIFO checking is on
+    bool out_of_order = scratch.deallocate(a);
+    std::cout << "Freeing the older block first: " << (out_of_order ? "accepted" : "rejected")
+              << " (LIFO checks " << (scratch.checks_lifo() ? "on" : "off") << ")" << std::endl;
+    if (!out_of_order) {
+        scratch.deallocate(b);
+    }
+    
+    scratch.rewind(mark);
+    std::cout << "Used after rewind: " << scratch.get_used_bytes()
+              << ", peak: " << scratch.get_peak_bytes() << " bytes" << std::endl;
+    
+    // A zero-size block sits exactly at the top, with or without LIFO checks
+    StackAllocator unchecked(1024, PoolBacking::Heap, false, false);
+    for (StackAllocator* stack : {&scratch, &unchecked}) {
+        stack->allocate(16);
+        void* empty = stack->allocate(0);
+        bool freed = stack->deallocate(empty);
+        std::cout << "Zero-size block freed (LIFO checks " << (stack->checks_lifo() ? "on" : "off")
+                  << "): " << (freed ? "SUCCESS" : "FAILED") << std::endl;
+        stack->reset();
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test the buddy allocator
+ * This function tests:
+ * 1. Rounding a request up and splitting the region down to it
+ * 2. block_size_of() reporting each block's size
+ * 3. Freed buddies merging back into one maximum block
+ */
+void test_buddy_allocator() {
+    std::cout << "\n=== Testing Buddy Allocator ===" << std::endl;
+    
+    try {
+        // 64 KiB region of 4 KiB minimum blocks: orders 0..4
+        BuddyAllocator buddy(64 * 1024, 4096);
+        std::cout << "Largest free block: " << buddy.get_largest_free_block() << " bytes" << std::endl;
+        
+        void* small = buddy.allocate(5000);   // Rounded up to 8 KiB
+        void* tiny = buddy.allocate(100);     // 4 KiB
+        std::cout << "Block sizes: " << buddy.block_size_of(small) << " and "
+                  << buddy.block_size_of(tiny) << " bytes" << std::endl;
+        
+        // Splitting 64 KiB down to 4 KiB left one free block in each order but the top
+        bool split = buddy.get_free_blocks(0) == 1 && buddy.get_free_blocks(2) == 1
+                     && buddy.get_free_blocks(3) == 1 && buddy.get_free_blocks(4) == 0;
+        std::cout << "Region split down to the request: " << (split ? "YES" : "NO")
+                  << ", largest free block: " << buddy.get_largest_free_block() << " bytes" << std::endl;
+        
+        buddy.deallocate(tiny);
+        buddy.deallocate(small);
+        bool merged = buddy.get_free_blocks(4) == 1
+                      && buddy.get_largest_free_block() == buddy.get_max_block();
+        std::cout << "Merged back into one " << buddy.get_max_block() << "-byte block: "
+                  << (merged ? "YES" : "NO") << std::endl;
+        std::cout << "Size of a freed block: " << buddy.block_size_of(small)
+                  << " (expected 0)" << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in buddy allocator test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
+}
+
+/**
+ * Test the TLSF allocator's boundary-tag merging
+ * This function tests:
+ * 1. Freeing blocks that merge with a free neighbour
+ * 2. Double-free detection after the block was merged into its predecessor
+ * 3. A later allocation not overlapping a still-live block
+ */
+void test_tlsf_allocator() {
+    std::cout << "\n=== Testing TLSF Allocator ===" << std::endl;
+    
+    try {
+        TlsfAllocator allocator(64 * 1024);
+        char* a = static_cast<char*>(allocator.allocate(64));
+        char* b = static_cast<char*>(allocator.allocate(64));
+        char* c = static_cast<char*>(allocator.allocate(64));
+        
+        // b merges backwards into the free a; its header must still say free
+        allocator.deallocate(a);
+        allocator.deallocate(b);
+        bool second_free = allocator.deallocate(b);
+        std::cout << "Double free after backward merge (should fail): "
+                  << (second_free ? "SUCCESS" : "FAILED") << std::endl;
+        std::cout << "Used blocks: " << allocator.get_used_blocks() << std::endl;
+        
+        char* d = static_cast<char*>(allocator.allocate(200));
+        bool overlaps = d < c + allocator.block_size_of(c) && c < d + allocator.block_size_of(d);
+        std::cout << "New block overlaps live block: " << (overlaps ? "YES" : "NO") << std::endl;
+        
+        allocator.deallocate(c);
+        allocator.deallocate(d);
+        std::cout << "Used blocks after freeing all: " << allocator.get_used_blocks() << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error in TLSF test: " << e.what() << std::endl;
+    }
+    
+    flush_diagnostics();
 }
 
 /**
@@ -189,6 +1162,26 @@ int main() {
     test_basic_allocator();     // Test core functionality
     test_allocator_limits();    // Test edge cases and limits
     test_error_handling();      // Test error conditions
+    test_free_list_mode();      // Test O(1) free-list mode
+    test_summary_levels();      // Test bitmap summary levels
+    test_next_fit();            // Test next-fit search policy
+    test_bulk_operations();     // Test batch allocate/free
+    test_concurrent_allocator();// Test lock-free shared pool
+    test_magazine_cache();      // Test per-thread magazines
+    test_size_classes();        // Test size-class pools
+    test_growable_allocator();  // Test slab chaining
+    test_trim();                // Test returning pages to the OS
+    test_lazy_commit();         // Test on-demand commit
+    test_alignment();           // Test aligned and padded blocks
+    test_numa_allocator();      // Test per-node pools
+    test_pool_allocator();      // Test standard container adapter
+    test_pool_resource();       // Test pmr upstream fallback
+    test_static_allocator();    // Test compile-time pool
+    test_object_pool();         // Test typed object pools
+    test_arena_allocator();     // Test bump allocation and reset
+    test_stack_allocator();     // Test LIFO scratch allocator
+    test_buddy_allocator();     // Test buddy split and merge
+    test_tlsf_allocator();      // Test TLSF merging and double frees
     
     // Final message
     std::cout << "\n" << std::string(50, '=') << std::endl;
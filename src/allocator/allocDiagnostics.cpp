@@ -0,0 +1,179 @@
+#include "allocDiagnostics.h"
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+std::atomic<uint64_t> g_diag_counts[static_cast<size_t>(DiagEvent::Count)];
+
+namespace {
+
+std::atomic<bool> g_diag_output{true};  // See set_diagnostics_output()
+
+}  // namespace
+
+namespace {
+
+struct DiagRecord {
+    DiagEvent event;
+    const void* ptr;
+    size_t value;
+    size_t extra;
+};
+
+void write_record(const DiagRecord& record) {
+    // Format first, then write the whole line at once, so it never lands
+    // in the middle of a line the program is printing
+    std::ostringstream out;
+    switch (record.event) {
+        case DiagEvent::PoolCreated:
+            out << "FixedAllocator created: " << record.value
+                << " blocks of " << record.extra
+                << " bytes each (total: " << record.value * record.extra << " bytes)\n";
+            break;
+        case DiagEvent::PoolDestroyed:
+            out << "FixedAllocator destroyed\n";
+            break;
+        case DiagEvent::InvalidPointer:
+            out << "Invalid pointer deallocation attempt: " << record.ptr << '\n';
+            break;
+        case DiagEvent::DoubleFree:
+            out << "Double-free detected for block at index: " << record.value << '\n';
+            break;
+        case DiagEvent::IndexOutOfRange:
+            out << "Error: block index " << record.value
+                << " out of bounds (max: " << record.extra - 1 << ")\n";
+            break;
+        case DiagEvent::CommitFailed:
+            out << "Failed to commit pool memory for block " << record.value << '\n';
+            break;
+        case DiagEvent::NumaBindFailed:
+            out << "Warning: could not bind pool to NUMA node " << record.value << '\n';
+            break;
+        case DiagEvent::LifoViolation:
+            out << "LIFO order violated at " << record.ptr
+                << " (stack top at offset " << record.value << ")\n";
+            break;
+        case DiagEvent::Deallocated:  // Counted only, never queued
+        case DiagEvent::Count:
+            break;
+    }
+    if (out.tellp() > 0) {
+        std::lock_guard<std::mutex> guard(diagnostics_output_lock());
+        std::cerr << out.str() << std::flush;
+    }
+}
+
+#if FIXALLOC_DIAGNOSTICS == FIXALLOC_DIAGNOSTICS_ASYNC
+
+// Set once the logger below is destroyed; constant-initialized and never
+// destroyed, so still readable by allocators destroyed later during static
+// teardown, from any thread
+std::atomic<bool> g_log_closed{false};
+
+// Messages are queued under a short lock and written by one background
+// thread, so callers never wait on a stream
+class AsyncDiagLog {
+public:
+    AsyncDiagLog() : busy_(false), stopping_(false), writer_([this] { run(); }) {}
+
+    ~AsyncDiagLog() {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        writer_.join();
+        g_log_closed.store(true);
+    }
+
+    void push(const DiagRecord& record) {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            pending_.push_back(record);
+        }
+        wake_.notify_one();
+    }
+
+    void flush() {
+        std::unique_lock<std::mutex> guard(lock_);
+        idle_.wait(guard, [this] { return pending_.empty() && !busy_; });
+    }
+
+private:
+    void run() {
+        std::vector<DiagRecord> batch;
+        std::unique_lock<std::mutex> guard(lock_);
+        for (;;) {
+            wake_.wait(guard, [this] { return stopping_ || !pending_.empty(); });
+            if (pending_.empty()) {
+                return;  // Stopping, and everything has been written
+            }
+            batch.swap(pending_);
+            busy_ = true;
+            guard.unlock();
+            for (const DiagRecord& record : batch) {
+                write_record(record);
+            }
+            batch.clear();
+            guard.lock();
+            busy_ = false;
+            idle_.notify_all();
+        }
+    }
+
+    std::mutex lock_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::vector<DiagRecord> pending_;
+    bool busy_;
+    bool stopping_;
+    std::thread writer_;  // Last: started once everything above exists
+};
+
+AsyncDiagLog& async_log() {
+    static AsyncDiagLog log;
+    return log;
+}
+
+#endif
+
+}  // namespace
+
+std::mutex& diagnostics_output_lock() {
+    // Never destroyed: allocators may still log during static teardown
+    static std::mutex* lock = new std::mutex;
+    return *lock;
+}
+
+uint64_t diagnostic_count(DiagEvent event) {
+    return g_diag_counts[static_cast<size_t>(event)].load(std::memory_order_relaxed);
+}
+
+void flush_diagnostics() {
+#if FIXALLOC_DIAGNOSTICS == FIXALLOC_DIAGNOSTICS_ASYNC
+    if (!g_log_closed.load()) {
+        async_log().flush();
+    }
+#endif
+}
+
+void set_diagnostics_output(bool enabled) {
+    g_diag_output.store(enabled, std::memory_order_relaxed);
+}
+
+void diag_log(DiagEvent event, const void* ptr, size_t value, size_t extra) {
+    if (!g_diag_output.load(std::memory_order_relaxed)) {
+        return;
+    }
+    DiagRecord record{event, ptr, value, extra};
+#if FIXALLOC_DIAGNOSTICS == FIXALLOC_DIAGNOSTICS_ASYNC
+    if (!g_log_closed.load()) {
+        async_log().push(record);
+        return;
+    }
+#endif
+    write_record(record);  // Not async, or static teardown after the writer stopped
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * Compile-time diagnostics policy for the allocators.
+ *
+ * Allocators report events through diag_event() instead of writing to
+ * std::cout / std::cerr. What that costs is fixed at compile time by
+ * FIXALLOC_DIAGNOSTICS:
+ *
+ *   FIXALLOC_DIAGNOSTICS_SILENT    diag_event() is an empty inline function
+ *   FIXALLOC_DIAGNOSTICS_COUNTERS  one relaxed atomic increment per event
+ *   FIXALLOC_DIAGNOSTICS_ASYNC     counters, plus errors and pool lifetime
+ *                                  messages queued for a background writer
+ *                                  that prints them to std::cerr
+ *
+ * The default is SILENT when NDEBUG is defined and ASYNC otherwise. The
+ * whole program must be built with one policy (CMake option of the same
+ * name). Per-block events such as Deallocated are counted, never logged.
+ */
+
+#define FIXALLOC_DIAGNOSTICS_SILENT   0
+#define FIXALLOC_DIAGNOSTICS_COUNTERS 1
+#define FIXALLOC_DIAGNOSTICS_ASYNC    2
+
+#ifndef FIXALLOC_DIAGNOSTICS
+#ifdef NDEBUG
+#define FIXALLOC_DIAGNOSTICS FIXALLOC_DIAGNOSTICS_SILENT
+#else
+#define FIXALLOC_DIAGNOSTICS FIXALLOC_DIAGNOSTICS_ASYNC
+#endif
+#endif
+
+enum class DiagEvent : uint8_t {
+    PoolCreated,      // value = blocks, extra = block size
+    PoolDestroyed,
+    Deallocated,      // value = block index
+    InvalidPointer,   // ptr = the pointer passed in
+    DoubleFree,       // value = block index
+    IndexOutOfRange,  // value = index, extra = number of blocks
+    CommitFailed,     // value = block index
+    NumaBindFailed,   // value = node
+    LifoViolation,    // ptr = block or marker address, value = current top offset
+    Count
+};
+
+constexpr bool kDiagnosticsEnabled = FIXALLOC_DIAGNOSTICS != FIXALLOC_DIAGNOSTICS_SILENT;
+
+// Number of times event was reported since startup (always 0 when silent)
+uint64_t diagnostic_count(DiagEvent event);
+
+// Block until every queued message has been written (no-op unless async)
+void flush_diagnostics();
+
+// Stop (false) or resume printing messages; events are still counted.
+// Messages reported while printing is off are dropped, not deferred.
+void set_diagnostics_output(bool enabled);
+
+// Held while a message is written, one whole line at a time. Take it around
+// your own multi-part console output to keep messages out of it.
+std::mutex& diagnostics_output_lock();
+
+// Implementation details used by the inline diag_event()
+extern std::atomic<uint64_t> g_diag_counts[static_cast<size_t>(DiagEvent::Count)];
+void diag_log(DiagEvent event, const void* ptr, size_t value, size_t extra);
+
+inline void diag_event(DiagEvent event, const void* ptr = nullptr,
+                       size_t value = 0, size_t extra = 0) {
+#if FIXALLOC_DIAGNOSTICS == FIXALLOC_DIAGNOSTICS_SILENT
+    (void)event; (void)ptr; (void)value; (void)extra;
+#else
+    g_diag_counts[static_cast<size_t>(event)].fetch_add(1, std::memory_order_relaxed);
+#if FIXALLOC_DIAGNOSTICS == FIXALLOC_DIAGNOSTICS_ASYNC
+    if (event != DiagEvent::Deallocated) {
+        diag_log(event, ptr, value, extra);
+    }
+#else
+    (void)ptr; (void)value; (void)extra;
+#endif
+#endif
+}
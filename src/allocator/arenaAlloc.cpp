@@ -0,0 +1,147 @@
+#include "arenaAlloc.h"
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+
+ArenaAllocator::ArenaAllocator(size_t chunk_size)
+    : chunk_size_(chunk_size)
+    , chunk_source_(nullptr)
+    , first_(nullptr)
+    , current_(nullptr)
+    , large_(nullptr)
+    , large_tail_(nullptr)
+    , cursor_(1)
+    , limit_(0)
+    , num_chunks_(0)
+    , reserved_bytes_(0)
+    , bytes_allocated_(0)
+{
+    if (chunk_size == 0) {
+        throw std::invalid_argument("Chunk size must be > 0");
+    }
+}
+
+ArenaAllocator::ArenaAllocator(FixedAllocator& chunk_source)
+    : ArenaAllocator(chunk_source.get_block_size() > sizeof(Chunk)
+                         ? chunk_source.get_block_size() - sizeof(Chunk) : 0)
+{
+    chunk_source_ = &chunk_source;
+}
+
+ArenaAllocator::~ArenaAllocator() {
+    free_chain(first_);
+    free_chain(large_);
+}
+
+void ArenaAllocator::reset() {
+    // Dedicated chunks join the front of the chain as ordinary chunks
+    if (large_) {
+        large_tail_->next = first_;
+        first_ = large_;
+        large_ = nullptr;
+        large_tail_ = nullptr;
+    }
+    bytes_allocated_ = 0;
+    if (first_) {
+        enter_chunk(first_);
+    }
+}
+
+void* ArenaAllocator::allocate_slow(size_t size, size_t alignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        return nullptr;  // Not a power of two
+    }
+    if (size > SIZE_MAX - alignment) {
+        return nullptr;  // Can't be satisfied
+    }
+    size_t needed = size + alignment - 1;  // Room for the worst-case padding
+    
+    if (needed > chunk_size_) {
+        // Too big for a regular chunk: take a big enough unused chunk out of
+        // the chain, or make one, and keep the current chunk filling
+        Chunk* chunk = nullptr;
+        for (Chunk* prev = current_; prev && prev->next; prev = prev->next) {
+            if (prev->next->capacity >= needed) {
+                chunk = prev->next;
+                prev->next = chunk->next;
+                break;
+            }
+        }
+        if (!chunk) {
+            chunk = new_chunk(needed, false);
+            if (!chunk) {
+                return nullptr;
+            }
+        }
+        chunk->next = large_;
+        if (!large_) {
+            large_tail_ = chunk;
+        }
+        large_ = chunk;
+        uintptr_t start = reinterpret_cast<uintptr_t>(chunk + 1);
+        bytes_allocated_ += size;
+        return reinterpret_cast<void*>((start + alignment - 1) & ~(uintptr_t(alignment) - 1));
+    }
+    
+    // Move along the chain to the first kept chunk the request fits in.
+    // Chunks skipped here stay unused until the next reset().
+    Chunk* chunk = current_ ? current_->next : nullptr;
+    while (chunk && chunk->capacity < needed) {
+        chunk = chunk->next;
+    }
+    if (!chunk) {
+        chunk = new_chunk(chunk_size_, chunk_source_ != nullptr);
+        if (!chunk) {
+            return nullptr;
+        }
+        // Insert after the current chunk so the chain stays in order of use
+        if (current_) {
+            chunk->next = current_->next;
+            current_->next = chunk;
+        } else {
+            chunk->next = nullptr;
+            first_ = chunk;
+        }
+    }
+    enter_chunk(chunk);
+    return allocate(size, alignment);
+}
+
+ArenaAllocator::Chunk* ArenaAllocator::new_chunk(size_t capacity, bool from_source) {
+    Chunk* chunk = nullptr;
+    if (from_source) {
+        chunk = static_cast<Chunk*>(chunk_source_->allocate());
+    }
+    if (!chunk) {
+        // No source, source full, or a dedicated chunk
+        from_source = false;
+        chunk = static_cast<Chunk*>(std::malloc(sizeof(Chunk) + capacity));
+        if (!chunk) {
+            return nullptr;
+        }
+    }
+    chunk->next = nullptr;
+    chunk->capacity = capacity;
+    chunk->from_source = from_source;
+    ++num_chunks_;
+    reserved_bytes_ += capacity;
+    return chunk;
+}
+
+void ArenaAllocator::enter_chunk(Chunk* chunk) {
+    current_ = chunk;
+    cursor_ = reinterpret_cast<uintptr_t>(chunk + 1);
+    limit_ = cursor_ + chunk->capacity;
+}
+
+void ArenaAllocator::free_chain(Chunk* chunk) {
+    while (chunk) {
+        Chunk* next = chunk->next;
+        if (chunk->from_source) {
+            chunk_source_->deallocate(chunk);
+        } else {
+            std::free(chunk);
+        }
+        chunk = next;
+    }
+}
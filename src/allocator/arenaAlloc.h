@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "fixAlloc.h"
+
+/**
+ * Monotonic (bump) allocator for data that is freed all at once.
+ *
+ * allocate() rounds the cursor up to the requested alignment and bumps it;
+ * there is no per-allocation bookkeeping and no individual free. When the
+ * current chunk is exhausted the arena moves to the next chunk in its
+ * chain, adding one if needed. reset() rewinds to the first chunk in O(1)
+ * and keeps every chunk for reuse; memory goes back only on destruction.
+ *
+ * Chunks come from the heap, or from a FixedAllocator whose blocks become
+ * the chunks (falling back to the heap when it is full). A request larger
+ * than a chunk gets a dedicated chunk (an unused big one from the chain,
+ * or a new heap chunk); the current chunk keeps filling, and reset()
+ * returns dedicated chunks to the chain for reuse.
+ * Not thread-safe.
+ */
+class ArenaAllocator {
+public:
+    static constexpr size_t kDefaultAlignment = alignof(std::max_align_t);
+
+    // Heap chunks of chunk_size usable bytes
+    explicit ArenaAllocator(size_t chunk_size = 64 * 1024);
+
+    // Chunks are blocks of chunk_source, which must outlive the arena
+    explicit ArenaAllocator(FixedAllocator& chunk_source);
+
+    ~ArenaAllocator();
+
+    // Delete copy constructor and assignment operator
+    ArenaAllocator(const ArenaAllocator&) = delete;
+    ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+    // alignment must be a power of two; nullptr only if the heap is exhausted
+    void* allocate(size_t size, size_t alignment = kDefaultAlignment) {
+        uintptr_t aligned = (cursor_ + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        if (aligned <= limit_ && size <= limit_ - aligned) {
+            cursor_ = aligned + size;
+            bytes_allocated_ += size;
+            return reinterpret_cast<void*>(aligned);
+        }
+        return allocate_slow(size, alignment);
+    }
+
+    // Construct a T in the arena. Its destructor is never run.
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        void* ptr = allocate(sizeof(T), alignof(T));
+        return ptr ? ::new (ptr) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    // Rewind to the start of the first chunk; all chunks are kept
+    void reset();
+
+    // Statistics methods
+    size_t get_chunk_size() const { return chunk_size_; }
+    size_t get_num_chunks() const { return num_chunks_; }
+    size_t get_reserved_bytes() const { return reserved_bytes_; }    // Usable bytes in all chunks
+    size_t get_allocated_bytes() const { return bytes_allocated_; }  // Requested since the last reset
+
+private:
+    // Header at the start of every chunk; usable bytes follow it
+    struct Chunk {
+        Chunk* next;
+        size_t capacity;
+        bool from_source;  // Block of chunk_source_, not heap memory
+    };
+
+    // Helper methods
+    void* allocate_slow(size_t size, size_t alignment);
+    Chunk* new_chunk(size_t capacity, bool from_source);
+    void enter_chunk(Chunk* chunk);
+    void free_chain(Chunk* chunk);
+
+    // Member variables
+    size_t chunk_size_;
+    FixedAllocator* chunk_source_;
+    Chunk* first_;            // Chain of chunks, in the order they are used
+    Chunk* current_;          // Chunk the cursor is in; nullptr only while first_ is
+    Chunk* large_;            // Dedicated chunks since the last reset, newest first
+    Chunk* large_tail_;       // Oldest of them, to splice the list into the chain in O(1)
+    uintptr_t cursor_;        // Next free byte in current_ (1 with no chunk, so every request misses)
+    uintptr_t limit_;         // End of current_ (0 with no chunk)
+    size_t num_chunks_;
+    size_t reserved_bytes_;
+    size_t bytes_allocated_;
+};
@@ -0,0 +1,128 @@
+#include "bitScan.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BITSCAN_X86 1
+#else
+#define BITSCAN_X86 0
+#endif
+
+namespace {
+
+size_t scan_scalar(const uint64_t* words, size_t count, uint64_t value) {
+    for (size_t i = 0; i < count; ++i) {
+        if (words[i] != value) {
+            return i;
+        }
+    }
+    return count;
+}
+
+#if BITSCAN_X86
+
+// 4 words (256 bits) per compare, two vectors per iteration
+__attribute__((target("avx2")))
+size_t scan_avx2(const uint64_t* words, size_t count, uint64_t value) {
+    const __m256i pattern = _mm256_set1_epi64x(static_cast<long long>(value));
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i + 4));
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi64(a, pattern), _mm256_cmpeq_epi64(b, pattern));
+        if (_mm256_movemask_epi8(eq) != -1) {
+            break;  // The differing word is within these 8
+        }
+    }
+    for (; i + 4 <= count; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        unsigned mask = static_cast<unsigned>(
+            _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, pattern))));
+        if (mask != 0xF) {
+            return i + static_cast<size_t>(__builtin_ctz(~mask & 0xF));
+        }
+    }
+    return i + scan_scalar(words + i, count - i, value);
+}
+
+// 8 words (512 bits) per compare
+__attribute__((target("avx512f")))
+size_t scan_avx512(const uint64_t* words, size_t count, uint64_t value) {
+    const __m512i pattern = _mm512_set1_epi64(static_cast<long long>(value));
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512i a = _mm512_loadu_si512(words + i);
+        __mmask8 ne = _mm512_cmpneq_epi64_mask(a, pattern);
+        if (ne != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(ne));
+        }
+    }
+    if (i < count) {
+        // Masked load for the tail; lanes past count read as equal
+        __mmask8 live = static_cast<__mmask8>((1u << (count - i)) - 1);
+        __m512i a = _mm512_mask_loadu_epi64(pattern, live, words + i);
+        __mmask8 ne = _mm512_cmpneq_epi64_mask(a, pattern);
+        if (ne != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(ne));
+        }
+    }
+    return count;
+}
+
+#endif  // BITSCAN_X86
+
+BitScanKernel detect_kernel() {
+#if BITSCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return BitScanKernel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return BitScanKernel::AVX2;
+    }
+#endif
+    return BitScanKernel::Scalar;
+}
+
+// Resolved once; function-local statics are initialized thread-safely
+BitScanKernel selected_kernel() {
+    static const BitScanKernel kernel = detect_kernel();
+    return kernel;
+}
+
+BitScanFn selected_fn() {
+    static const BitScanFn fn = get_bit_scan_kernel(selected_kernel());
+    return fn;
+}
+
+}  // namespace
+
+size_t find_first_word_not_equal(const uint64_t* words, size_t count, uint64_t value) {
+    return selected_fn()(words, count, value);
+}
+
+BitScanKernel active_bit_scan_kernel() {
+    return selected_kernel();
+}
+
+const char* bit_scan_kernel_name(BitScanKernel kernel) {
+    switch (kernel) {
+        case BitScanKernel::AVX2:   return "avx2";
+        case BitScanKernel::AVX512: return "avx512";
+        default:                    return "scalar";
+    }
+}
+
+BitScanFn get_bit_scan_kernel(BitScanKernel kernel) {
+    switch (kernel) {
+        case BitScanKernel::Scalar:
+            return scan_scalar;
+#if BITSCAN_X86
+        case BitScanKernel::AVX2:
+            return __builtin_cpu_supports("avx2") ? scan_avx2 : nullptr;
+        case BitScanKernel::AVX512:
+            return __builtin_cpu_supports("avx512f") ? scan_avx512 : nullptr;
+#endif
+        default:
+            return nullptr;
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Vectorized bitmap word scans with runtime CPU dispatch.
+ *
+ * Binaries are built for a generic target, so the AVX2 and AVX-512
+ * kernels are compiled with per-function target attributes and the best
+ * one supported by the running CPU is picked on first use.
+ */
+
+enum class BitScanKernel {
+    Scalar,
+    AVX2,
+    AVX512
+};
+
+// Index of the first word in [0, count) that is not equal to value, or count if none
+using BitScanFn = size_t (*)(const uint64_t* words, size_t count, uint64_t value);
+
+// Dispatches to the best kernel the running CPU supports
+size_t find_first_word_not_equal(const uint64_t* words, size_t count, uint64_t value);
+
+// Kernel chosen by find_first_word_not_equal()
+BitScanKernel active_bit_scan_kernel();
+const char* bit_scan_kernel_name(BitScanKernel kernel);
+
+// A specific kernel, or nullptr if the CPU (or build target) doesn't support it
+BitScanFn get_bit_scan_kernel(BitScanKernel kernel);
@@ -0,0 +1,193 @@
+#include "buddyAlloc.h"
+#include "allocDiagnostics.h"
+#include <stdexcept>
+
+namespace {
+
+constexpr size_t kBitsPerWord = 64;
+
+size_t floor_log2(size_t value) {
+    return kBitsPerWord - 1 - static_cast<size_t>(__builtin_clzll(value));
+}
+
+}  // namespace
+
+BuddyAllocator::BuddyAllocator(size_t region_size, size_t min_block, PoolBacking backing)
+    : min_block_(min_block)
+    , min_shift_(0)
+    , max_order_(0)
+    , capacity_(0)
+    , used_bytes_(0)
+    , nonempty_orders_(0)
+{
+    // Input validation
+    if (min_block < 2 * sizeof(void*) || (min_block & (min_block - 1)) != 0) {
+        throw std::invalid_argument("Minimum block size must be a power of two >= 2 pointers");
+    }
+    if (region_size < min_block) {
+        throw std::invalid_argument("Region must hold at least one minimum block");
+    }
+    
+    min_shift_ = floor_log2(min_block);
+    size_t num_min_blocks = region_size >> min_shift_;
+    capacity_ = num_min_blocks << min_shift_;
+    max_order_ = floor_log2(num_min_blocks);
+    
+    region_ = allocate_pool_region(capacity_, get_max_block(), backing);
+    
+    free_lists_.assign(max_order_ + 1, nullptr);
+    free_counts_.assign(max_order_ + 1, 0);
+    free_bits_.resize(max_order_ + 1);
+    for (size_t order = 0; order <= max_order_; ++order) {
+        size_t blocks = num_min_blocks >> order;
+        free_bits_[order].assign((blocks + kBitsPerWord - 1) / kBitsPerWord, 0);
+    }
+    block_orders_.assign(num_min_blocks, 0);
+    
+    // Cover the region with the largest blocks that fit, biggest first
+    size_t offset = 0;
+    for (size_t order = max_order_ + 1; order-- > 0;) {
+        size_t size = min_block_ << order;
+        if (capacity_ - offset >= size) {
+            push_free(offset, order);
+            offset += size;
+        }
+    }
+}
+
+BuddyAllocator::~BuddyAllocator() {
+    release_pool_region(region_);
+}
+
+void* BuddyAllocator::allocate(size_t size) {
+    size_t order = order_for(size);
+    if (order > max_order_) {
+        return nullptr;  // Larger than the largest block
+    }
+    
+    // Smallest non-empty order that is big enough
+    uint64_t candidates = nonempty_orders_ & (~uint64_t(0) << order);
+    if (candidates == 0) {
+        return nullptr;  // No free block that big
+    }
+    size_t found = static_cast<size_t>(__builtin_ctzll(candidates));
+    size_t offset = static_cast<size_t>(reinterpret_cast<uint8_t*>(free_lists_[found]) - region_.base);
+    remove_free(offset, found);
+    
+    // Split down to the requested order; the upper halves stay free
+    while (found > order) {
+        --found;
+        push_free(offset + (min_block_ << found), found);
+    }
+    
+    block_orders_[offset >> min_shift_] = static_cast<uint8_t>(order + 1);
+    used_bytes_ += min_block_ << order;
+    return region_.base + offset;
+}
+
+bool BuddyAllocator::deallocate(void* ptr) {
+    if (!is_valid_pointer(ptr)) {
+        diag_event(DiagEvent::InvalidPointer, ptr);
+        return false;  // Invalid pointer
+    }
+    
+    size_t offset = static_cast<size_t>(static_cast<uint8_t*>(ptr) - region_.base);
+    uint8_t& tag = block_orders_[offset >> min_shift_];
+    if (tag == 0) {
+        diag_event(DiagEvent::DoubleFree, ptr, offset >> min_shift_);
+        return false;  // Not the start of an allocated block
+    }
+    size_t order = tag - 1u;
+    tag = 0;
+    used_bytes_ -= min_block_ << order;
+    
+    // Merge with the buddy while it is free and whole
+    while (order < max_order_) {
+        size_t size = min_block_ << order;
+        size_t buddy = offset ^ size;
+        if (buddy > capacity_ - size || !is_free(buddy, order)) {
+            break;
+        }
+        remove_free(buddy, order);
+        offset &= ~size;
+        ++order;
+    }
+    push_free(offset, order);
+    
+    diag_event(DiagEvent::Deallocated, ptr, offset >> min_shift_);
+    return true;
+}
+
+bool BuddyAllocator::is_valid_pointer(const void* ptr) const {
+    // Below the region, the unsigned offset wraps past capacity_
+    size_t offset = reinterpret_cast<uintptr_t>(ptr) - reinterpret_cast<uintptr_t>(region_.base);
+    return offset < capacity_ && (offset & (min_block_ - 1)) == 0;
+}
+
+size_t BuddyAllocator::block_size_of(const void* ptr) const {
+    if (!is_valid_pointer(ptr)) {
+        return 0;
+    }
+    size_t offset = static_cast<size_t>(static_cast<const uint8_t*>(ptr) - region_.base);
+    uint8_t tag = block_orders_[offset >> min_shift_];
+    return tag ? min_block_ << (tag - 1u) : 0;
+}
+
+size_t BuddyAllocator::block_size_for(size_t size) const {
+    size_t order = order_for(size);
+    return order <= max_order_ ? min_block_ << order : 0;
+}
+
+size_t BuddyAllocator::get_largest_free_block() const {
+    if (nonempty_orders_ == 0) {
+        return 0;
+    }
+    return min_block_ << floor_log2(static_cast<size_t>(nonempty_orders_));
+}
+
+size_t BuddyAllocator::order_for(size_t size) const {
+    // Smallest order whose block holds size bytes (> max_order_ if none)
+    if (size <= min_block_) {
+        return 0;
+    }
+    size_t blocks = ((size - 1) >> min_shift_) + 1;
+    return blocks == 1 ? 0 : floor_log2(blocks - 1) + 1;
+}
+
+void BuddyAllocator::push_free(size_t offset, size_t order) {
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(region_.base + offset);
+    block->prev = nullptr;
+    block->next = free_lists_[order];
+    if (block->next) {
+        block->next->prev = block;
+    }
+    free_lists_[order] = block;
+    ++free_counts_[order];
+    nonempty_orders_ |= uint64_t(1) << order;
+    
+    size_t index = offset >> (min_shift_ + order);
+    free_bits_[order][index / kBitsPerWord] |= uint64_t(1) << (index % kBitsPerWord);
+}
+
+void BuddyAllocator::remove_free(size_t offset, size_t order) {
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(region_.base + offset);
+    if (block->prev) {
+        block->prev->next = block->next;
+    } else {
+        free_lists_[order] = block->next;
+    }
+    if (block->next) {
+        block->next->prev = block->prev;
+    }
+    if (--free_counts_[order] == 0) {
+        nonempty_orders_ &= ~(uint64_t(1) << order);
+    }
+    
+    size_t index = offset >> (min_shift_ + order);
+    free_bits_[order][index / kBitsPerWord] &= ~(uint64_t(1) << (index % kBitsPerWord));
+}
+
+bool BuddyAllocator::is_free(size_t offset, size_t order) const {
+    size_t index = offset >> (min_shift_ + order);
+    return (free_bits_[order][index / kBitsPerWord] >> (index % kBitsPerWord)) & 1;
+}
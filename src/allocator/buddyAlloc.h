@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "poolMemory.h"
+
+/**
+ * Binary buddy allocator for power-of-two blocks over one region.
+ *
+ * Block sizes are min_block << order. allocate() rounds the request up to
+ * the next block size, takes the smallest free block that fits (one
+ * bit scan of a mask of non-empty orders) and splits it down, pushing the
+ * unused halves onto their orders' free lists. deallocate() merges the
+ * block with its buddy for as long as the buddy is free. Both are
+ * O(log(region / min_block)).
+ *
+ * Free blocks are linked through their first bytes (doubly, so a buddy can
+ * be unlinked in O(1)); a bitmap per order says which blocks are free, and
+ * one byte per min_block records the order of every allocated block, so
+ * deallocate() needs only the pointer and catches double frees. The region
+ * comes from allocate_pool_region() and is aligned to the largest block,
+ * so every block is aligned to its own size. A region that isn't a power
+ * of two is covered by the largest blocks that fit; blocks whose buddy
+ * would lie past the end never merge. Not thread-safe.
+ */
+class BuddyAllocator {
+public:
+    static constexpr size_t kDefaultMinBlock = 4096;
+
+    // region_size is rounded down to a multiple of min_block, which must be
+    // a power of two of at least two pointers
+    explicit BuddyAllocator(size_t region_size, size_t min_block = kDefaultMinBlock,
+                            PoolBacking backing = PoolBacking::Heap);
+    ~BuddyAllocator();
+
+    // Delete copy constructor and assignment operator
+    BuddyAllocator(const BuddyAllocator&) = delete;
+    BuddyAllocator& operator=(const BuddyAllocator&) = delete;
+
+    // nullptr if size is larger than the largest block or no block that
+    // big is free
+    void* allocate(size_t size);
+    bool deallocate(void* ptr);
+
+    bool is_valid_pointer(const void* ptr) const;
+
+    // Size of the block ptr points to (0 if it isn't an allocated block)
+    size_t block_size_of(const void* ptr) const;
+
+    // Block size allocate(size) would use (0 if too big)
+    size_t block_size_for(size_t size) const;
+
+    // Statistics methods
+    size_t get_min_block() const { return min_block_; }
+    size_t get_max_block() const { return min_block_ << max_order_; }
+    size_t get_num_orders() const { return max_order_ + 1; }
+    size_t get_capacity() const { return capacity_; }
+    size_t get_used_bytes() const { return used_bytes_; }
+    size_t get_free_bytes() const { return capacity_ - used_bytes_; }
+    size_t get_largest_free_block() const;
+    size_t get_free_blocks(size_t order) const { return free_counts_[order]; }
+    PoolBacking get_backing() const { return region_.backing; }
+
+private:
+    // Link stored in the first bytes of every free block
+    struct FreeBlock {
+        FreeBlock* prev;
+        FreeBlock* next;
+    };
+
+    // Helper methods
+    size_t order_for(size_t size) const;
+    void push_free(size_t offset, size_t order);
+    void remove_free(size_t offset, size_t order);
+    bool is_free(size_t offset, size_t order) const;
+
+    // Member variables
+    PoolRegion region_;
+    size_t min_block_;
+    size_t min_shift_;           // log2(min_block_)
+    size_t max_order_;           // Largest block is min_block_ << max_order_
+    size_t capacity_;            // Usable bytes: a multiple of min_block_
+    size_t used_bytes_;          // In allocated blocks (including rounding)
+    uint64_t nonempty_orders_;   // Bit k set when free_lists_[k] is not empty
+    std::vector<FreeBlock*> free_lists_;            // Per order
+    std::vector<size_t> free_counts_;               // Per order
+    std::vector<std::vector<uint64_t>> free_bits_;  // Per order, 1 bit per block: 1 = free
+    std::vector<uint8_t> block_orders_;  // Per min_block: order + 1 at the start of an allocated block, else 0
+};
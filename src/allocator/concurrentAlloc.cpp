@@ -0,0 +1,344 @@
+#include "concurrentAlloc.h"
+#include "allocDiagnostics.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+ConcurrentFixedAllocator::ConcurrentFixedAllocator(size_t block_size, size_t num_blocks,
+                                                   const FixedAllocatorOptions& options)
+    : block_size_(block_size)
+    , num_blocks_(num_blocks)
+    , num_words_((num_blocks + kBitsPerWord - 1) / kBitsPerWord)
+    , alignment_(sizeof(void*))  // At least pointer size, see below
+    , mode_(options.mode)
+    , track_blocks_(options.mode == AllocationMode::Bitmap || options.detect_double_free)
+    , next_untouched_(0)
+    , memory_pool_(nullptr)
+{
+    // Input validation
+    if (block_size == 0 || num_blocks == 0) {
+        throw std::invalid_argument("Block size and number of blocks must be > 0");
+    }
+    if (mode_ == AllocationMode::FreeList && num_blocks > TreiberFreeStack::kMaxBlocks) {
+        throw std::invalid_argument("Too many blocks for the free-list stack");
+    }
+    
+    if (options.alignment == 0 || (options.alignment & (options.alignment - 1)) != 0) {
+        throw std::invalid_argument("Alignment must be a power of two");
+    }
+    alignment_ = std::max(alignment_, options.alignment);
+    if (options.cache_line_isolate) {
+        alignment_ = std::max(alignment_, kCacheLineSize);
+    }
+    
+    // Align block size to alignment boundary
+    block_size_ = (block_size + alignment_ - 1) & ~(alignment_ - 1);
+    
+    // Allocate memory pool
+    size_t total_size = block_size_ * num_blocks_;
+    region_ = allocate_pool_region(total_size, alignment_, options.backing,
+                                   false, options.numa_node);
+    memory_pool_ = region_.base;
+    std::memset(memory_pool_, 0, total_size);
+    free_stack_.reset(memory_pool_, block_size_);
+    
+    // Initialize bitmap - all blocks free, tail bits of the last word used
+    if (track_blocks_) {
+        block_bitmap_.reset(new std::atomic<uint64_t>[num_words_]);
+        for (size_t w = 0; w < num_words_; ++w) {
+            block_bitmap_[w].store(0, std::memory_order_relaxed);
+        }
+        size_t tail_bits = num_blocks_ % kBitsPerWord;
+        if (tail_bits != 0) {
+            block_bitmap_[num_words_ - 1].store(kFullWord << tail_bits, std::memory_order_relaxed);
+        }
+    }
+    
+    // Start each shard in its own slice of the bitmap
+    shards_.reset(new Shard[kNumShards]);
+    for (size_t i = 0; i < kNumShards; ++i) {
+        shards_[i].hint.store(i * num_words_ / kNumShards, std::memory_order_relaxed);
+    }
+}
+
+ConcurrentFixedAllocator::~ConcurrentFixedAllocator() {
+    if (memory_pool_) {
+        release_pool_region(region_);
+        memory_pool_ = nullptr;
+    }
+}
+
+void* ConcurrentFixedAllocator::allocate() {
+    if (mode_ == AllocationMode::FreeList) {
+        void* ptr = free_list_take();
+        if (ptr) {
+            current_shard().used.fetch_add(1, std::memory_order_relaxed);
+        }
+        return ptr;
+    }
+    
+    Shard& shard = current_shard();
+    size_t start = shard.hint.load(std::memory_order_relaxed);
+    
+    // Visit every word once, starting at the shard's hint and wrapping
+    for (size_t n = 0; n < num_words_; ++n) {
+        size_t w = start + n;
+        if (w >= num_words_) {
+            w -= num_words_;
+        }
+        
+        std::atomic<uint64_t>& word = block_bitmap_[w];
+        uint64_t current = word.load(std::memory_order_relaxed);
+        while (current != kFullWord) {
+            // Try to claim the lowest free bit; if another thread won it,
+            // fetch_or hands back the fresh word to retry with
+            uint64_t bit = ~current & (current + 1);
+            uint64_t previous = word.fetch_or(bit, std::memory_order_acquire);
+            if ((previous & bit) == 0) {
+                if (w != start) {
+                    shard.hint.store(w, std::memory_order_relaxed);
+                }
+                shard.used.fetch_add(1, std::memory_order_relaxed);
+                size_t index = w * kBitsPerWord + static_cast<size_t>(__builtin_ctzll(bit));
+                return block_index_to_ptr(index);
+            }
+            current = previous | bit;
+        }
+    }
+    return nullptr;  // No free blocks available
+}
+
+bool ConcurrentFixedAllocator::deallocate(void* ptr) {
+    if (!is_valid_pointer(ptr)) {
+        diag_event(DiagEvent::InvalidPointer, ptr);
+        return false;  // Invalid pointer
+    }
+    
+    size_t index = ptr_to_block_index(ptr);
+    uint64_t bit = uint64_t(1) << (index % kBitsPerWord);
+    
+    // Wait-free release; the previous value tells us if it was already free
+    if (track_blocks_) {
+        uint64_t previous = block_bitmap_[index / kBitsPerWord].fetch_and(~bit, std::memory_order_release);
+        if ((previous & bit) == 0) {
+            diag_event(DiagEvent::DoubleFree, nullptr, index);
+            return false;  // Block already free
+        }
+    }
+    
+    if (mode_ == AllocationMode::FreeList) {
+        free_stack_.push(ptr);
+    }
+    current_shard().used.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+size_t ConcurrentFixedAllocator::allocate_bulk(void** out, size_t n) {
+    if (mode_ == AllocationMode::FreeList) {
+        size_t count = 0;
+        while (count < n) {
+            void* ptr = free_list_take();
+            if (!ptr) {
+                break;  // Pool exhausted
+            }
+            out[count++] = ptr;
+        }
+        current_shard().used.fetch_add(static_cast<int64_t>(count), std::memory_order_relaxed);
+        return count;
+    }
+    
+    Shard& shard = current_shard();
+    size_t start = shard.hint.load(std::memory_order_relaxed);
+    size_t count = 0;
+    
+    for (size_t k = 0; k < num_words_ && count < n; ++k) {
+        size_t w = start + k;
+        if (w >= num_words_) {
+            w -= num_words_;
+        }
+        
+        std::atomic<uint64_t>& word = block_bitmap_[w];
+        uint64_t current = word.load(std::memory_order_relaxed);
+        while (current != kFullWord && count < n) {
+            // Pick up to n - count of the free bits and claim them together
+            uint64_t free_bits = ~current;
+            uint64_t claim = 0;
+            for (size_t taken = 0; free_bits != 0 && count + taken < n; ++taken) {
+                uint64_t bit = free_bits & (0 - free_bits);
+                claim |= bit;
+                free_bits ^= bit;
+            }
+            if (word.compare_exchange_weak(current, current | claim, std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+                for (uint64_t bits = claim; bits != 0; bits &= bits - 1) {
+                    out[count++] = block_index_to_ptr(w * kBitsPerWord + static_cast<size_t>(__builtin_ctzll(bits)));
+                }
+                shard.hint.store(w, std::memory_order_relaxed);
+                break;
+            }
+            // CAS failed: current now holds the fresh word, retry
+        }
+    }
+    
+    shard.used.fetch_add(static_cast<int64_t>(count), std::memory_order_relaxed);
+    return count;
+}
+
+size_t ConcurrentFixedAllocator::deallocate_bulk(void* const* ptrs, size_t n) {
+    if (mode_ == AllocationMode::FreeList) {
+        size_t freed = free_list_release(ptrs, n);
+        current_shard().used.fetch_sub(static_cast<int64_t>(freed), std::memory_order_relaxed);
+        return freed;
+    }
+    
+    size_t freed = 0;
+    size_t run_word = num_words_;
+    uint64_t run_mask = 0;
+    
+    // Accumulate consecutive pointers that share a bitmap word and release
+    // each run with one fetch_and
+    for (size_t i = 0; i < n; ++i) {
+        void* ptr = ptrs[i];
+        if (!is_valid_pointer(ptr)) {
+            diag_event(DiagEvent::InvalidPointer, ptr);
+            continue;
+        }
+        size_t index = ptr_to_block_index(ptr);
+        size_t w = index / kBitsPerWord;
+        uint64_t bit = uint64_t(1) << (index % kBitsPerWord);
+        if (w != run_word || (run_mask & bit) != 0) {
+            freed += release_bits(run_word, run_mask);
+            run_word = w;
+            run_mask = 0;
+        }
+        run_mask |= bit;
+    }
+    freed += release_bits(run_word, run_mask);
+    
+    current_shard().used.fetch_sub(static_cast<int64_t>(freed), std::memory_order_relaxed);
+    return freed;
+}
+
+bool ConcurrentFixedAllocator::is_valid_pointer(void* ptr) const {
+    if (!ptr || !memory_pool_) {
+        return false;
+    }
+    
+    // Check if pointer is within our memory pool
+    uint8_t* byte_ptr = static_cast<uint8_t*>(ptr);
+    if (byte_ptr < memory_pool_ || byte_ptr >= memory_pool_ + (block_size_ * num_blocks_)) {
+        return false;
+    }
+    
+    // Check if pointer is aligned to block boundary
+    size_t offset = byte_ptr - memory_pool_;
+    return (offset % block_size_) == 0;
+}
+
+size_t ConcurrentFixedAllocator::get_used_blocks() const {
+    // A shard can go negative when blocks are freed by a different thread
+    // than allocated them; only the sum is meaningful
+    int64_t used = 0;
+    for (size_t i = 0; i < kNumShards; ++i) {
+        used += shards_[i].used.load(std::memory_order_relaxed);
+    }
+    return used > 0 ? static_cast<size_t>(used) : 0;
+}
+
+size_t ConcurrentFixedAllocator::get_free_blocks() const {
+    return num_blocks_ - get_used_blocks();
+}
+
+bool ConcurrentFixedAllocator::is_full() const {
+    return get_used_blocks() == num_blocks_;
+}
+
+bool ConcurrentFixedAllocator::is_empty() const {
+    return get_used_blocks() == 0;
+}
+
+// Private helper methods implementation
+ConcurrentFixedAllocator::Shard& ConcurrentFixedAllocator::current_shard() {
+    // Threads take shard slots round-robin the first time they touch any pool
+    static std::atomic<size_t> next_slot{0};
+    thread_local size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed) % kNumShards;
+    return shards_[slot];
+}
+
+size_t ConcurrentFixedAllocator::release_bits(size_t word_index, uint64_t mask) {
+    if (mask == 0) {
+        return 0;
+    }
+    uint64_t previous = block_bitmap_[word_index].fetch_and(~mask, std::memory_order_release);
+    uint64_t released = previous & mask;
+    if (kDiagnosticsEnabled && released != mask) {
+        for (uint64_t bits = mask & ~released; bits != 0; bits &= bits - 1) {
+            diag_event(DiagEvent::DoubleFree, nullptr,
+                       word_index * kBitsPerWord + static_cast<size_t>(__builtin_ctzll(bits)));
+        }
+    }
+    return static_cast<size_t>(__builtin_popcountll(released));
+}
+
+void* ConcurrentFixedAllocator::free_list_take() {
+    void* ptr = free_stack_.pop();
+    if (!ptr) {
+        // Stack empty: hand out the next never-used block
+        size_t index = next_untouched_.fetch_add(1, std::memory_order_relaxed);
+        if (index >= num_blocks_) {
+            return nullptr;  // No free blocks available
+        }
+        ptr = block_index_to_ptr(index);
+    }
+    
+    if (track_blocks_) {
+        size_t index = ptr_to_block_index(ptr);
+        block_bitmap_[index / kBitsPerWord].fetch_or(uint64_t(1) << (index % kBitsPerWord),
+                                                     std::memory_order_acquire);
+    }
+    return ptr;
+}
+
+size_t ConcurrentFixedAllocator::free_list_release(void* const* ptrs, size_t n) {
+    // Link the valid blocks into a private chain, then publish it with one CAS
+    void* first = nullptr;
+    void* last = nullptr;
+    size_t freed = 0;
+    for (size_t i = 0; i < n; ++i) {
+        void* ptr = ptrs[i];
+        if (!is_valid_pointer(ptr)) {
+            diag_event(DiagEvent::InvalidPointer, ptr);
+            continue;
+        }
+        if (track_blocks_) {
+            size_t index = ptr_to_block_index(ptr);
+            uint64_t bit = uint64_t(1) << (index % kBitsPerWord);
+            uint64_t previous = block_bitmap_[index / kBitsPerWord].fetch_and(~bit, std::memory_order_release);
+            if ((previous & bit) == 0) {
+                diag_event(DiagEvent::DoubleFree, nullptr, index);
+                continue;
+            }
+        }
+        free_stack_.link(ptr, first);
+        first = ptr;
+        if (!last) {
+            last = ptr;
+        }
+        ++freed;
+    }
+    if (first) {
+        free_stack_.push_chain(first, last);
+    }
+    return freed;
+}
+
+size_t ConcurrentFixedAllocator::ptr_to_block_index(void* ptr) const {
+    uint8_t* byte_ptr = static_cast<uint8_t*>(ptr);
+    return (byte_ptr - memory_pool_) / block_size_;
+}
+
+void* ConcurrentFixedAllocator::block_index_to_ptr(size_t index) const {
+    return memory_pool_ + (index * block_size_);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "fixAlloc.h"
+#include "treiberStack.h"
+
+/**
+ * Lock-free fixed-size allocator that can be shared by any number of threads.
+ *
+ * Same pool layout as FixedAllocator, but each bitmap word is a
+ * std::atomic<uint64_t>: allocate() claims a bit with fetch_or and
+ * deallocate() releases it with a single wait-free fetch_and. Threads are
+ * spread over shards that each keep their own search hint and usage
+ * counter, so they start searching in different parts of the bitmap and
+ * never write the same counter cache line.
+ *
+ * AllocationMode::FreeList replaces the bitmap search with a lock-free
+ * Treiber stack of free blocks; the atomic bitmap is then only kept for
+ * double-free detection (options.detect_double_free). options.backing
+ * and options.numa_node select the pool memory; options.fit,
+ * options.auto_trim_bytes and options.lazy_commit are ignored.
+ */
+class ConcurrentFixedAllocator {
+public:
+    ConcurrentFixedAllocator(size_t block_size, size_t num_blocks,
+                             const FixedAllocatorOptions& options = FixedAllocatorOptions());
+    ~ConcurrentFixedAllocator();
+    
+    // Delete copy constructor and assignment operator
+    ConcurrentFixedAllocator(const ConcurrentFixedAllocator&) = delete;
+    ConcurrentFixedAllocator& operator=(const ConcurrentFixedAllocator&) = delete;
+    
+    void* allocate();
+    bool deallocate(void* ptr);
+    bool is_valid_pointer(void* ptr) const;
+    
+    // Batch versions: claim several bits of a word with one CAS / release a
+    // run of same-word pointers with one fetch_and (FreeList mode: push the
+    // whole batch with one CAS). Return the number of blocks actually
+    // allocated / freed.
+    size_t allocate_bulk(void** out, size_t n);
+    size_t deallocate_bulk(void* const* ptrs, size_t n);
+    
+    // Statistics methods - exact only when no other thread is mid-operation
+    size_t get_block_size() const { return block_size_; }
+    size_t get_alignment() const { return alignment_; }
+    size_t get_total_blocks() const { return num_blocks_; }
+    size_t get_free_blocks() const;
+    size_t get_used_blocks() const;
+    bool is_full() const;
+    bool is_empty() const;
+    AllocationMode get_mode() const { return mode_; }
+    int get_numa_node() const { return region_.numa_node; }  // -1 if not bound
+
+private:
+    static constexpr size_t kBitsPerWord = 64;
+    static constexpr uint64_t kFullWord = ~uint64_t(0);
+    static constexpr size_t kNumShards = 64;
+    
+    // Per-shard state, padded so shards never share a cache line
+    struct alignas(kCacheLineSize) Shard {
+        std::atomic<int64_t> used{0};  // Net allocations made through this shard
+        std::atomic<size_t> hint{0};   // Word where this shard last found a free bit
+    };
+    
+    // Helper methods
+    Shard& current_shard();
+    size_t ptr_to_block_index(void* ptr) const;
+    void* block_index_to_ptr(size_t index) const;
+    size_t release_bits(size_t word_index, uint64_t mask);
+    void* free_list_take();
+    size_t free_list_release(void* const* ptrs, size_t n);
+    
+    // Member variables
+    size_t block_size_;
+    size_t num_blocks_;
+    size_t num_words_;
+    size_t alignment_;
+    AllocationMode mode_;
+    bool track_blocks_;                      // Atomic bitmap maintained (always in Bitmap mode)
+    TreiberFreeStack free_stack_;            // FreeList mode: freed blocks
+    std::atomic<size_t> next_untouched_;     // FreeList mode: blocks at or past this index were never handed out
+    PoolRegion region_;
+    uint8_t* memory_pool_;
+    std::unique_ptr<std::atomic<uint64_t>[]> block_bitmap_;  // 1 bit per block: 0 = free, 1 = used
+    std::unique_ptr<Shard[]> shards_;
+};
@@ -1,53 +1,111 @@
 #include "fixAlloc.h"
+#include "bitScan.h"
+#include "allocDiagnostics.h"
 #include <stdexcept>
+#include <algorithm>
 #include <cstdlib>
 #include <cassert>
 #include <cstring>
-#include <iostream>
+#include <sys/mman.h>
 
-FixedAllocator::FixedAllocator(size_t block_size, size_t num_blocks)
+FixedAllocator::FixedAllocator(size_t block_size, size_t num_blocks,
+                               const FixedAllocatorOptions& options)
     : block_size_(block_size)
     , num_blocks_(num_blocks)
-    , alignment_(sizeof(void*))  // Align to pointer size
+    , alignment_(sizeof(void*))  // At least pointer size, see below
     , free_blocks_count_(num_blocks)
+    , mode_(options.mode)
+    , fit_(options.fit)
+    , search_hint_(0)
+    , track_blocks_(options.mode == AllocationMode::Bitmap || options.detect_double_free)
+    , free_list_head_(nullptr)
+    , next_untouched_(0)
+    , page_size_(0)
+    , auto_trim_bytes_(options.auto_trim_bytes)
+    , freed_since_trim_(0)
+    , committed_blocks_(0)
 {
     // Input validation
     if (block_size == 0 || num_blocks == 0) {
         throw std::invalid_argument("Block size and number of blocks must be > 0");
     }
     
+    if (options.alignment == 0 || (options.alignment & (options.alignment - 1)) != 0) {
+        throw std::invalid_argument("Alignment must be a power of two");
+    }
+    alignment_ = std::max(alignment_, options.alignment);
+    if (options.cache_line_isolate) {
+        alignment_ = std::max(alignment_, kCacheLineSize);
+    }
+    
     // Align block size to alignment boundary
     block_size_ = (block_size + alignment_ - 1) & ~(alignment_ - 1);
     
     // Allocate memory pool
     size_t total_size = block_size_ * num_blocks_;
-    void* ptr = nullptr;
-    if (posix_memalign(&ptr, alignment_, total_size) != 0) {
-        throw std::bad_alloc();
+    region_ = allocate_pool_region(total_size, alignment_, options.backing,
+                                   options.lazy_commit, options.numa_node);
+    memory_pool_ = region_.base;
+    page_size_ = region_.page_size;  // Trim granularity: whole huge pages when backed by them
+    committed_blocks_ = std::min(num_blocks_, region_.committed / block_size_);
+    
+    // Initialize memory (optional, for debugging). A lazily committed pool
+    // is left alone: its pages are zero-filled by the kernel on first touch.
+    if (!options.lazy_commit) {
+        std::memset(memory_pool_, 0, total_size);
     }
-    memory_pool_ = static_cast<uint8_t*>(ptr);
     
-    // Initialize memory (optional, for debugging)
-    std::memset(memory_pool_, 0, total_size);
+    // Resident pages are only tracked for pools that trim; otherwise
+    // tracking starts with the first explicit trim()
+    if (mode_ == AllocationMode::Bitmap && auto_trim_bytes_ != 0) {
+        start_page_tracking();
+    }
     
-    // Initialize bitmap - all blocks start as free
-    block_bitmap_.resize(num_blocks_, false);  // false = free
+    // Initialize bitmap - all blocks start as free.
+    // FreeList mode without double-free detection needs no bitmap at all.
+    if (track_blocks_) {
+        size_t num_words = (num_blocks_ + kBitsPerWord - 1) / kBitsPerWord;
+        block_bitmap_.assign(num_words, 0);  // 0 = free
+        
+        // Bits past num_blocks_ in the last word are marked used so the
+        // word-level search never hands them out
+        size_t tail_bits = num_blocks_ % kBitsPerWord;
+        if (tail_bits != 0) {
+            block_bitmap_.back() = kFullWord << tail_bits;
+        }
+        
+        // Build summary levels - each bit says "the word below has a free block".
+        // Levels are added until the top one is short enough for a vector scan.
+        size_t below = num_words;
+        while (below > kScanWords) {
+            size_t level_words = (below + kBitsPerWord - 1) / kBitsPerWord;
+            std::vector<uint64_t> level(level_words, kFullWord);
+            size_t level_tail = below % kBitsPerWord;
+            if (level_tail != 0) {
+                level.back() = ~(kFullWord << level_tail);
+            }
+            summary_levels_.push_back(std::move(level));
+            below = level_words;
+        }
+    }
     
-    std::cout << "FixedAllocator created: " << num_blocks_ 
-              << " blocks of " << block_size_ 
-              << " bytes each (total: " << total_size << " bytes)" << std::endl;
+    diag_event(DiagEvent::PoolCreated, memory_pool_, num_blocks_, block_size_);
 }
 
 FixedAllocator::~FixedAllocator() {
     if (memory_pool_) {
-        std::free(memory_pool_);
+        release_pool_region(region_);
         memory_pool_ = nullptr;
     }
     
-    std::cout << "FixedAllocator destroyed" << std::endl;
+    diag_event(DiagEvent::PoolDestroyed);
 }
 
 void* FixedAllocator::allocate() {
+    if (mode_ == AllocationMode::FreeList) {
+        return free_list_pop();
+    }
+    
     // Find a free block
     size_t free_index = find_free_block();
     
@@ -56,9 +114,13 @@ void* FixedAllocator::allocate() {
         // No free blocks available
         return nullptr;
     }
+    if (free_index >= committed_blocks_ && !commit_through(free_index)) {
+        return nullptr;
+    }
     
-    // Mark the block as used
+    // Mark the block as used and start the next search just past it
     mark_block_used(free_index);
+    search_hint_ = free_index + 1;
     
     // Return pointer to the block
     return block_index_to_ptr(free_index);
@@ -67,7 +129,7 @@ void* FixedAllocator::allocate() {
 bool FixedAllocator::deallocate(void* ptr) {
     // 1. Validate pointer using is_valid_pointer()
     if (!is_valid_pointer(ptr)) {
-        std::cerr << "Invalid pointer deallocation attempt: " << ptr << std::endl;
+        diag_event(DiagEvent::InvalidPointer, ptr);
         return false;  // Invalid pointer
     }
     
@@ -75,17 +137,184 @@ bool FixedAllocator::deallocate(void* ptr) {
     size_t block_index = ptr_to_block_index(ptr);
     
     // 3. Check if block is already free (double-free detection)
-    if (is_block_free(block_index)) {
-        std::cerr << "Double-free detected for block at index: " << block_index << std::endl;
+    if (track_blocks_ && is_block_free(block_index)) {
+        diag_event(DiagEvent::DoubleFree, ptr, block_index);
         return false;  // Block already free
     }
     
     // 4. Mark block as free
-    mark_block_free(block_index);
-    std::cout << "Deallocated block at index: " << block_index << std::endl;
+    if (mode_ == AllocationMode::FreeList) {
+        free_list_push(ptr);
+    } else {
+        mark_block_free(block_index);
+    }
+    diag_event(DiagEvent::Deallocated, ptr, block_index);
+    maybe_auto_trim();
     return true;  // Successful deallocation
 }
 
+size_t FixedAllocator::allocate_bulk(void** out, size_t n) {
+    size_t count = 0;
+    
+    if (mode_ == AllocationMode::FreeList) {
+        while (count < n) {
+            void* ptr = free_list_take();
+            if (!ptr) {
+                break;  // Pool exhausted
+            }
+            if (track_blocks_) {
+                size_t index = ptr_to_block_index(ptr);
+                set_word_bits(index / kBitsPerWord, uint64_t(1) << (index % kBitsPerWord));
+            }
+            out[count++] = ptr;
+        }
+    } else {
+        while (count < n) {
+            size_t index = find_free_block();
+            if (index >= num_blocks_) {
+                break;  // Pool exhausted
+            }
+            
+            // Claim the free bits of this word from index upward in one update
+            size_t word_index = index / kBitsPerWord;
+            size_t word_last = std::min(num_blocks_, (word_index + 1) * kBitsPerWord) - 1;
+            if (word_last >= committed_blocks_ && !commit_through(word_last)) {
+                break;
+            }
+            uint64_t free_bits = ~block_bitmap_[word_index] & (kFullWord << (index % kBitsPerWord));
+            uint64_t taken = 0;
+            while (free_bits != 0 && count < n) {
+                uint64_t bit = free_bits & (0 - free_bits);  // Lowest set bit
+                index = word_index * kBitsPerWord + static_cast<size_t>(__builtin_ctzll(free_bits));
+                out[count++] = block_index_to_ptr(index);
+                taken |= bit;
+                free_bits ^= bit;
+            }
+            set_word_bits(word_index, taken);
+            search_hint_ = index + 1;
+        }
+    }
+    
+    free_blocks_count_ -= count;
+    return count;
+}
+
+size_t FixedAllocator::deallocate_bulk(void* const* ptrs, size_t n) {
+    size_t freed = 0;
+    size_t lowest_freed = num_blocks_;
+    size_t indices[kBulkChunk];
+    
+    for (size_t base = 0; base < n; base += kBulkChunk) {
+        size_t chunk = std::min(kBulkChunk, n - base);
+        
+        // 1. Validate pointers and convert them to block indices
+        size_t valid = 0;
+        for (size_t i = 0; i < chunk; ++i) {
+            void* ptr = ptrs[base + i];
+            if (!is_valid_pointer(ptr)) {
+                diag_event(DiagEvent::InvalidPointer, ptr);
+                continue;
+            }
+            indices[valid++] = ptr_to_block_index(ptr);
+        }
+        
+        if (mode_ == AllocationMode::FreeList) {
+            // 2a. Push each block; the side bitmap catches double frees
+            for (size_t i = 0; i < valid; ++i) {
+                size_t index = indices[i];
+                if (track_blocks_) {
+                    if (is_block_free(index)) {
+                        diag_event(DiagEvent::DoubleFree, nullptr, index);
+                        continue;
+                    }
+                    clear_word_bits(index / kBitsPerWord, uint64_t(1) << (index % kBitsPerWord));
+                }
+                free_list_put(block_index_to_ptr(index));
+                ++freed;
+            }
+            continue;
+        }
+        
+        // 2b. Sort so blocks sharing a bitmap word are adjacent, then clear
+        // each word once
+        std::sort(indices, indices + valid);
+        size_t i = 0;
+        while (i < valid) {
+            size_t word_index = indices[i] / kBitsPerWord;
+            uint64_t mask = 0;
+            for (; i < valid && indices[i] / kBitsPerWord == word_index; ++i) {
+                uint64_t bit = uint64_t(1) << (indices[i] % kBitsPerWord);
+                // Already free, or repeated within this batch
+                if ((block_bitmap_[word_index] & bit) == 0 || (mask & bit) != 0) {
+                    diag_event(DiagEvent::DoubleFree, nullptr, indices[i]);
+                    continue;
+                }
+                mask |= bit;
+            }
+            if (mask != 0) {
+                clear_word_bits(word_index, mask);
+                freed += static_cast<size_t>(__builtin_popcountll(mask));
+                lowest_freed = std::min(lowest_freed,
+                    word_index * kBitsPerWord + static_cast<size_t>(__builtin_ctzll(mask)));
+            }
+        }
+    }
+    
+    free_blocks_count_ += freed;
+    if (fit_ == FitPolicy::FirstFit && lowest_freed < search_hint_) {
+        search_hint_ = lowest_freed;
+    }
+    maybe_auto_trim();
+    return freed;
+}
+
+size_t FixedAllocator::trim() {
+    freed_since_trim_ = 0;
+    if (mode_ != AllocationMode::Bitmap) {
+        return 0;  // FreeList mode: free blocks hold list links
+    }
+    if (resident_pages_.empty()) {
+        start_page_tracking();
+    }
+    
+    uint8_t* page_base = memory_pool_ - reinterpret_cast<uintptr_t>(memory_pool_) % page_size_;
+    uint8_t* pool_end = memory_pool_ + block_size_ * num_blocks_;
+    size_t num_pages = (pool_end - page_base + page_size_ - 1) / page_size_;
+    size_t released = 0;
+    
+    // Collect runs of resident pages with no live blocks and release each
+    // run with one madvise call
+    size_t run_start = 0;
+    size_t run_length = 0;
+    for (size_t page = 0; page <= num_pages; ++page) {
+        bool release = false;
+        if (page < num_pages
+            && (resident_pages_[page / kBitsPerWord] & (uint64_t(1) << (page % kBitsPerWord))) != 0) {
+            uint8_t* start = page_base + page * page_size_;
+            uint8_t* end = start + page_size_;
+            // Partial pages at either end of the pool are shared with other data
+            if (start >= memory_pool_ && end <= pool_end) {
+                size_t first = (start - memory_pool_) / block_size_;
+                size_t last = (end - 1 - memory_pool_) / block_size_;
+                release = block_range_is_free(first, last);
+            }
+        }
+        
+        if (release) {
+            if (run_length == 0) {
+                run_start = page;
+            }
+            ++run_length;
+            resident_pages_[page / kBitsPerWord] &= ~(uint64_t(1) << (page % kBitsPerWord));
+        } else if (run_length != 0) {
+            madvise(page_base + run_start * page_size_, run_length * page_size_, MADV_DONTNEED);
+            released += run_length * page_size_;
+            run_length = 0;
+        }
+    }
+    return released;
+}
+
 bool FixedAllocator::is_valid_pointer(void* ptr) const {
     if (!ptr || !memory_pool_) {
         return false;
@@ -129,40 +358,264 @@ void* FixedAllocator::block_index_to_ptr(size_t index) const {
 }
 
 size_t FixedAllocator::find_free_block() const {
-    // Linear search for now (can be optimized later with bit operations)
-    for (size_t i = 0; i < num_blocks_; ++i) {
-        if (!block_bitmap_[i]) {  // false = free
-            return i;
+    size_t index = find_free_block_from(search_hint_);
+    
+    // First fit: every block below the hint is used, so a miss means the
+    // pool is full. Next fit: wrap around and search the prefix.
+    if (index >= num_blocks_ && fit_ == FitPolicy::NextFit && search_hint_ != 0) {
+        index = find_free_block_from(0);
+    }
+    return index;
+}
+
+size_t FixedAllocator::find_free_block_from(size_t start) const {
+    if (start >= num_blocks_) {
+        return num_blocks_;
+    }
+    
+    // Free bits at or after start in its own leaf word
+    size_t word_index = start / kBitsPerWord;
+    uint64_t free_bits = ~block_bitmap_[word_index] & (kFullWord << (start % kBitsPerWord));
+    if (free_bits != 0) {
+        return word_index * kBitsPerWord + static_cast<size_t>(__builtin_ctzll(free_bits));
+    }
+    
+    // Small pool: vector-scan the remaining leaf words
+    if (summary_levels_.empty()) {
+        size_t next = word_index + 1;
+        size_t w = next + find_first_word_not_equal(block_bitmap_.data() + next,
+                                                    block_bitmap_.size() - next, kFullWord);
+        if (w == block_bitmap_.size()) {
+            return num_blocks_;  // No free block found
         }
+        return w * kBitsPerWord + static_cast<size_t>(__builtin_ctzll(~block_bitmap_[w]));
+    }
+    
+    // Climb the summary levels looking for a set bit after the current position;
+    // pos is a bit index within the level being examined
+    size_t pos = word_index + 1;
+    const size_t top = summary_levels_.size() - 1;
+    for (size_t level = 0; level < top; ++level) {
+        const std::vector<uint64_t>& words = summary_levels_[level];
+        size_t w = pos / kBitsPerWord;
+        if (w >= words.size()) {
+            return num_blocks_;
+        }
+        uint64_t bits = words[w] & (kFullWord << (pos % kBitsPerWord));
+        if (bits != 0) {
+            return descend_to_block(level, w * kBitsPerWord + static_cast<size_t>(__builtin_ctzll(bits)));
+        }
+        pos = w + 1;
+    }
+    
+    // Top level: mask the first word, vector-scan the rest
+    const std::vector<uint64_t>& words = summary_levels_[top];
+    size_t w = pos / kBitsPerWord;
+    if (w >= words.size()) {
+        return num_blocks_;
+    }
+    uint64_t bits = words[w] & (kFullWord << (pos % kBitsPerWord));
+    if (bits == 0) {
+        w = w + 1 + find_first_word_not_equal(words.data() + w + 1, words.size() - w - 1, 0);
+        if (w == words.size()) {
+            return num_blocks_;  // No free block found
+        }
+        bits = words[w];
+    }
+    return descend_to_block(top, w * kBitsPerWord + static_cast<size_t>(__builtin_ctzll(bits)));
+}
+
+size_t FixedAllocator::descend_to_block(size_t level, size_t bit) const {
+    // bit is set in summary_levels_[level]; follow the lowest set bits down,
+    // one ctz per level, to the first free block beneath it
+    while (level-- > 0) {
+        bit = bit * kBitsPerWord + static_cast<size_t>(__builtin_ctzll(summary_levels_[level][bit]));
+    }
+    return bit * kBitsPerWord + static_cast<size_t>(__builtin_ctzll(~block_bitmap_[bit]));
+}
+
+void FixedAllocator::summary_clear(size_t word_index) {
+    // Leaf word became full: clear its summary bit, propagating upward while
+    // the summary word we just emptied was the last free path
+    for (auto& level : summary_levels_) {
+        uint64_t& word = level[word_index / kBitsPerWord];
+        word &= ~(uint64_t(1) << (word_index % kBitsPerWord));
+        if (word != 0) {
+            return;
+        }
+        word_index /= kBitsPerWord;
+    }
+}
+
+void FixedAllocator::summary_set(size_t word_index) {
+    // Leaf word gained a free block: set its summary bit, propagating upward
+    // while the summary word was previously empty
+    for (auto& level : summary_levels_) {
+        uint64_t& word = level[word_index / kBitsPerWord];
+        bool was_empty = (word == 0);
+        word |= uint64_t(1) << (word_index % kBitsPerWord);
+        if (!was_empty) {
+            return;
+        }
+        word_index /= kBitsPerWord;
+    }
+}
+
+void FixedAllocator::set_word_bits(size_t word_index, uint64_t mask) {
+    // Mark the blocks in mask used; the counter is the caller's job
+    if (!resident_pages_.empty()) {
+        size_t first = word_index * kBitsPerWord + static_cast<size_t>(__builtin_ctzll(mask));
+        size_t last = word_index * kBitsPerWord + kBitsPerWord - 1 - static_cast<size_t>(__builtin_clzll(mask));
+        touch_block_pages(first, last);
+    }
+    uint64_t& word = block_bitmap_[word_index];
+    word |= mask;
+    if (word == kFullWord) {
+        summary_clear(word_index);
+    }
+}
+
+void FixedAllocator::clear_word_bits(size_t word_index, uint64_t mask) {
+    // Mark the blocks in mask free; the counter is the caller's job
+    uint64_t& word = block_bitmap_[word_index];
+    if (word == kFullWord) {
+        summary_set(word_index);
+    }
+    word &= ~mask;
+    if (auto_trim_bytes_ != 0) {
+        freed_since_trim_ += static_cast<size_t>(__builtin_popcountll(mask)) * block_size_;
+    }
+}
+
+void FixedAllocator::start_page_tracking() {
+    // Every committed page may hold data until trim() has looked at it.
+    // Pages are counted from the one holding the pool start; only those
+    // entirely inside the pool are ever trimmed.
+    size_t page_offset = reinterpret_cast<uintptr_t>(memory_pool_) % page_size_;
+    size_t num_pages = (page_offset + block_size_ * num_blocks_ + page_size_ - 1) / page_size_;
+    resident_pages_.assign((num_pages + kBitsPerWord - 1) / kBitsPerWord, 0);
+    size_t committed_pages = std::min(num_pages,
+                                      (page_offset + region_.committed + page_size_ - 1) / page_size_);
+    for (size_t page = 0; page < committed_pages; ++page) {
+        resident_pages_[page / kBitsPerWord] |= uint64_t(1) << (page % kBitsPerWord);
+    }
+}
+
+void FixedAllocator::touch_block_pages(size_t first, size_t last) {
+    // Mark every page blocks first..last overlap as holding data again
+    size_t page_offset = reinterpret_cast<uintptr_t>(memory_pool_) % page_size_;
+    size_t first_page = (page_offset + first * block_size_) / page_size_;
+    size_t last_page = (page_offset + (last + 1) * block_size_ - 1) / page_size_;
+    for (size_t page = first_page; page <= last_page; ++page) {
+        resident_pages_[page / kBitsPerWord] |= uint64_t(1) << (page % kBitsPerWord);
+    }
+}
+
+bool FixedAllocator::commit_through(size_t index) {
+    // Lazy commit: extend the usable prefix of the pool to cover the block
+    if (!commit_pool_region(region_, (index + 1) * block_size_)) {
+        diag_event(DiagEvent::CommitFailed, nullptr, index);
+        return false;
+    }
+    committed_blocks_ = std::min(num_blocks_, region_.committed / block_size_);
+    return true;
+}
+
+bool FixedAllocator::block_range_is_free(size_t first, size_t last) const {
+    // True if no block in [first, last] is used, checked a word at a time
+    while (first <= last) {
+        size_t word_index = first / kBitsPerWord;
+        size_t bit = first % kBitsPerWord;
+        size_t span = std::min(kBitsPerWord - bit, last - first + 1);
+        uint64_t mask = (span == kBitsPerWord ? kFullWord : ((uint64_t(1) << span) - 1)) << bit;
+        if ((block_bitmap_[word_index] & mask) != 0) {
+            return false;
+        }
+        first += span;
+    }
+    return true;
+}
+
+void FixedAllocator::maybe_auto_trim() {
+    if (auto_trim_bytes_ != 0 && freed_since_trim_ >= auto_trim_bytes_) {
+        trim();
     }
-    return num_blocks_;  // No free block found
 }
 
 void FixedAllocator::mark_block_used(size_t index) {
     if (index >= num_blocks_) {
-        std::cerr << "Error: mark_block_used() - index " << index 
-                  << " out of bounds (max: " << num_blocks_ - 1 << ")" << std::endl;
+        diag_event(DiagEvent::IndexOutOfRange, nullptr, index, num_blocks_);
         return;
     }
-    block_bitmap_[index] = true;
+    set_word_bits(index / kBitsPerWord, uint64_t(1) << (index % kBitsPerWord));
     --free_blocks_count_;
 }
 
 void FixedAllocator::mark_block_free(size_t index) {
     if (index >= num_blocks_) {
-        std::cerr << "Error: mark_block_free() - index " << index 
-                  << " out of bounds (max: " << num_blocks_ - 1 << ")" << std::endl;
+        diag_event(DiagEvent::IndexOutOfRange, nullptr, index, num_blocks_);
         return;
     }
-    block_bitmap_[index] = false;
+    clear_word_bits(index / kBitsPerWord, uint64_t(1) << (index % kBitsPerWord));
     ++free_blocks_count_;
+    
+    // First fit: keep the hint at or below the lowest free block
+    if (fit_ == FitPolicy::FirstFit && index < search_hint_) {
+        search_hint_ = index;
+    }
 }
 
 bool FixedAllocator::is_block_free(size_t index) const {
     if (index >= num_blocks_) {
-        std::cerr << "Error: is_block_free() - index " << index 
-                  << " out of bounds (max: " << num_blocks_ - 1 << ")" << std::endl;
+        diag_event(DiagEvent::IndexOutOfRange, nullptr, index, num_blocks_);
         return false;  // Invalid index
     }
-    return !block_bitmap_[index];  // false = free
-}
\ No newline at end of file
+    return (block_bitmap_[index / kBitsPerWord] & (uint64_t(1) << (index % kBitsPerWord))) == 0;
+}
+
+void* FixedAllocator::free_list_take() {
+    if (free_list_head_) {
+        // Reuse the most recently freed block
+        void* ptr = free_list_head_;
+        free_list_head_ = free_list_head_->next;
+        return ptr;
+    }
+    if (next_untouched_ < num_blocks_) {
+        // Free list is empty: hand out the next never-used block, so the
+        // list never has to be threaded through the whole pool up front
+        if (next_untouched_ >= committed_blocks_ && !commit_through(next_untouched_)) {
+            return nullptr;
+        }
+        return block_index_to_ptr(next_untouched_++);
+    }
+    return nullptr;  // No free blocks available
+}
+
+void FixedAllocator::free_list_put(void* ptr) {
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = free_list_head_;
+    free_list_head_ = block;
+}
+
+void* FixedAllocator::free_list_pop() {
+    void* ptr = free_list_take();
+    if (!ptr) {
+        return nullptr;
+    }
+    
+    if (track_blocks_) {
+        mark_block_used(ptr_to_block_index(ptr));
+    } else {
+        --free_blocks_count_;
+    }
+    return ptr;
+}
+
+void FixedAllocator::free_list_push(void* ptr) {
+    if (track_blocks_) {
+        mark_block_free(ptr_to_block_index(ptr));
+    } else {
+        ++free_blocks_count_;
+    }
+    free_list_put(ptr);
+}
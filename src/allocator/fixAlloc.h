@@ -3,10 +3,65 @@
 #include <cstddef>
 #include <cstdint>
 #include <vector>
+#include "poolMemory.h"
+
+// Destructive interference size: the unit two threads must not share
+#if defined(__APPLE__) && defined(__aarch64__)
+constexpr size_t kCacheLineSize = 128;
+#else
+constexpr size_t kCacheLineSize = 64;
+#endif
+
+// How the allocator finds a free block
+enum class AllocationMode {
+    Bitmap,    // Lowest-address free block via the bitmap
+    FreeList   // O(1) pop/push on a free list threaded through the free blocks
+};
+
+// Where Bitmap mode starts searching
+enum class FitPolicy {
+    FirstFit,  // Lowest free block; the cursor tracks the lowest possibly-free index
+    NextFit    // First free block after the last one handed out, wrapping around
+};
+
+struct FixedAllocatorOptions {
+    AllocationMode mode = AllocationMode::Bitmap;
+    FitPolicy fit = FitPolicy::FirstFit;
+    
+    // Block alignment, any power of two (raised to at least sizeof(void*)).
+    // The block size is rounded up to a multiple of it.
+    size_t alignment = sizeof(void*);
+    
+    // Give every block its own cache line(s) so threads working on
+    // neighbouring blocks don't false-share: raises the alignment to
+    // kCacheLineSize. Use alignment = 128 to also defeat adjacent-line prefetch.
+    bool cache_line_isolate = false;
+    
+    // FreeList mode only: keep the side bitmap so deallocate() can still
+    // detect double frees. The bitmap is always kept in Bitmap mode.
+    bool detect_double_free = true;
+    
+    // Bitmap mode only: call trim() automatically once at least this many
+    // bytes have been freed since the last trim (0 = only explicit trim())
+    size_t auto_trim_bytes = 0;
+    
+    // Pool memory source; huge-page backings fall back gracefully
+    PoolBacking backing = PoolBacking::Heap;
+    
+    // Only reserve address space up front and commit it as the highest
+    // block handed out grows; the pool is not zeroed (fresh pages already
+    // are). Forces an mmap backing when backing is Heap.
+    bool lazy_commit = false;
+    
+    // Bind the pool's pages to this NUMA node (-1 = default policy).
+    // Best effort, see get_numa_node(). Forces an mmap backing.
+    int numa_node = -1;
+};
 
 class FixedAllocator {
 public:
-    FixedAllocator(size_t block_size, size_t num_blocks);
+    FixedAllocator(size_t block_size, size_t num_blocks,
+                   const FixedAllocatorOptions& options = FixedAllocatorOptions());
     ~FixedAllocator();
     
     // Delete copy constructor and assignment operator
@@ -15,32 +70,94 @@ public:
     
     void* allocate();
     bool deallocate(void* ptr);
+    
+    // Batch versions: fill out[0..n) / free ptrs[0..n) and return how many
+    // blocks were actually allocated / freed
+    size_t allocate_bulk(void** out, size_t n);
+    size_t deallocate_bulk(void* const* ptrs, size_t n);
+    
+    // Return pages that hold no live blocks to the OS (madvise MADV_DONTNEED),
+    // only pages entirely inside the pool, so a Heap backing's neighbours are
+    // never touched. On Linux they read back as zero when reused; elsewhere
+    // (macOS) MADV_DONTNEED is only a hint, and a released page may keep or
+    // lose its old contents. Returns the number of bytes released.
+    // A no-op in FreeList mode, where free blocks hold the list links.
+    size_t trim();
     bool is_valid_pointer(void* ptr) const;
     
     // Statistics methods
     size_t get_block_size() const { return block_size_; }
+    size_t get_alignment() const { return alignment_; }
     size_t get_total_blocks() const { return num_blocks_; }
+    const void* get_pool_base() const { return memory_pool_; }
+    size_t get_pool_size() const { return block_size_ * num_blocks_; }
     size_t get_free_blocks() const;
     size_t get_used_blocks() const;
     bool is_full() const;
     bool is_empty() const;
+    AllocationMode get_mode() const { return mode_; }
+    FitPolicy get_fit_policy() const { return fit_; }
+    PoolBacking get_backing() const { return region_.backing; }  // After fallbacks
+    size_t get_committed_bytes() const { return region_.committed; }
+    int get_numa_node() const { return region_.numa_node; }  // -1 if not bound
 
 private:
+    // Free list node stored in the first bytes of each free block
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+    
     // Helper methods
     size_t ptr_to_block_index(void* ptr) const;
     void* block_index_to_ptr(size_t index) const;
     size_t find_free_block() const;
+    size_t find_free_block_from(size_t start) const;
+    size_t descend_to_block(size_t level, size_t bit) const;
     void mark_block_used(size_t index);
     void mark_block_free(size_t index);
     bool is_block_free(size_t index) const;
+    void summary_set(size_t word_index);
+    void summary_clear(size_t word_index);
+    void set_word_bits(size_t word_index, uint64_t mask);
+    void clear_word_bits(size_t word_index, uint64_t mask);
+    void start_page_tracking();
+    void touch_block_pages(size_t first, size_t last);
+    bool commit_through(size_t index);
+    bool block_range_is_free(size_t first, size_t last) const;
+    void maybe_auto_trim();
+    void* free_list_take();
+    void free_list_put(void* ptr);
+    void* free_list_pop();
+    void free_list_push(void* ptr);
+    
+    // Bitmap geometry: one bit per block, 64 blocks per word
+    static constexpr size_t kBitsPerWord = 64;
+    static constexpr uint64_t kFullWord = ~uint64_t(0);
+    // Word count at or below which a level is vector-scanned instead of summarized
+    static constexpr size_t kScanWords = 64;
+    // deallocate_bulk() sorts indices in chunks of this many pointers
+    static constexpr size_t kBulkChunk = 256;
     
     // Member variables
     size_t block_size_;
     size_t num_blocks_;
     size_t alignment_;
     size_t free_blocks_count_;
+    AllocationMode mode_;
+    FitPolicy fit_;
+    size_t search_hint_;        // Bitmap mode: index where the next search starts
+    bool track_blocks_;         // Bitmap maintained (always in Bitmap mode)
+    FreeBlock* free_list_head_; // FreeList mode: most recently freed block
+    size_t next_untouched_;     // FreeList mode: blocks at or past this index were never handed out
+    size_t page_size_;
+    size_t auto_trim_bytes_;
+    size_t freed_since_trim_;   // Bytes freed since the last trim() (counted only with auto_trim_bytes_)
+    PoolRegion region_;
+    size_t committed_blocks_;   // Blocks below this index lie in committed memory
     uint8_t* memory_pool_;
-    std::vector<bool> block_bitmap_;  // This is the bitmap for tracking free/used blocks
+    std::vector<uint64_t> resident_pages_;  // Bitmap mode, once trimming: 1 bit per page, 1 = may hold data
+    std::vector<uint64_t> block_bitmap_;  // 1 bit per block: 0 = free, 1 = used
+    std::vector<std::vector<uint64_t>> summary_levels_;  // 1 bit per word below: 1 = has a free block
 };
 // #pragma once
 
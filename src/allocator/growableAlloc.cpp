@@ -0,0 +1,168 @@
+#include "growableAlloc.h"
+#include "allocDiagnostics.h"
+#include <algorithm>
+#include <stdexcept>
+
+GrowableFixedAllocator::GrowableFixedAllocator(size_t block_size, size_t blocks_per_slab,
+                                               size_t max_slabs, const FixedAllocatorOptions& options)
+    : block_size_(block_size)
+    , blocks_per_slab_(blocks_per_slab)
+    , max_slabs_(max_slabs)
+    , num_slabs_(0)
+    , used_blocks_(0)
+    , auto_trim_bytes_(options.auto_trim_bytes)
+    , freed_since_trim_(0)
+    , options_(options)
+{
+    if (block_size == 0 || blocks_per_slab == 0) {
+        throw std::invalid_argument("Block size and blocks per slab must be > 0");
+    }
+    if (options.alignment == 0 || (options.alignment & (options.alignment - 1)) != 0) {
+        throw std::invalid_argument("Alignment must be a power of two");
+    }
+    
+    // Same rounding as each slab applies, so block_size_ is the real
+    // footprint of a block (freed_since_trim_ counts in it)
+    size_t alignment = std::max(sizeof(void*), options.alignment);
+    if (options.cache_line_isolate) {
+        alignment = std::max(alignment, kCacheLineSize);
+    }
+    block_size_ = (block_size + alignment - 1) & ~(alignment - 1);
+    
+    // Trimming is driven from here so empty slabs can be released whole
+    options_.auto_trim_bytes = 0;
+}
+
+void* GrowableFixedAllocator::allocate() {
+    size_t slab;
+    if (!available_.empty()) {
+        slab = available_.back();
+    } else {
+        if (max_slabs_ != 0 && num_slabs_ >= max_slabs_) {
+            return nullptr;  // Growth limit reached
+        }
+        slab = add_slab();
+    }
+    
+    FixedAllocator& pool = *slabs_[slab];
+    void* ptr = pool.allocate();
+    if (ptr) {
+        ++used_blocks_;
+    }
+    
+    // Full slabs leave the available list so they are never searched. So
+    // does a slab that failed (lazy commit refused): the next call moves on
+    // to another slab, and a later deallocate() puts it back.
+    if (!ptr || pool.is_full()) {
+        available_.pop_back();
+        is_available_[slab] = false;
+    }
+    return ptr;
+}
+
+bool GrowableFixedAllocator::deallocate(void* ptr) {
+    size_t slab = find_slab(ptr);
+    if (slab == slabs_.size()) {
+        diag_event(DiagEvent::InvalidPointer, ptr);
+        return false;  // Not from any slab
+    }
+    
+    if (!slabs_[slab]->deallocate(ptr)) {
+        return false;  // Misaligned or double free, already reported
+    }
+    --used_blocks_;
+    
+    if (!is_available_[slab]) {
+        available_.push_back(slab);
+        is_available_[slab] = true;
+    }
+    
+    freed_since_trim_ += block_size_;
+    if (auto_trim_bytes_ != 0 && freed_since_trim_ >= auto_trim_bytes_) {
+        trim();
+    }
+    return true;
+}
+
+size_t GrowableFixedAllocator::trim() {
+    freed_since_trim_ = 0;
+    size_t released = 0;
+    bool kept_empty = false;  // One empty slab stays so alternating load doesn't recreate it
+    for (size_t slab = 0; slab < slabs_.size(); ++slab) {
+        if (!slabs_[slab]) {
+            continue;
+        }
+        if (slabs_[slab]->is_empty() && kept_empty) {
+            // Trim first: the heap may keep the freed slab's pages mapped
+            released += slabs_[slab]->trim();
+            release_slab(slab);
+        } else {
+            kept_empty = kept_empty || slabs_[slab]->is_empty();
+            released += slabs_[slab]->trim();
+        }
+    }
+    return released;
+}
+
+bool GrowableFixedAllocator::is_valid_pointer(void* ptr) const {
+    size_t slab = find_slab(ptr);
+    return slab != slabs_.size() && slabs_[slab]->is_valid_pointer(ptr);
+}
+
+size_t GrowableFixedAllocator::get_free_blocks() const {
+    return get_total_blocks() - used_blocks_;
+}
+
+// Private helper methods implementation
+size_t GrowableFixedAllocator::add_slab() {
+    // Reuse a released slot before growing the slab table
+    size_t slab;
+    if (!free_slots_.empty()) {
+        slab = free_slots_.back();
+        free_slots_.pop_back();
+        slabs_[slab].reset(new FixedAllocator(block_size_, blocks_per_slab_, options_));
+        is_available_[slab] = true;
+    } else {
+        slab = slabs_.size();
+        slabs_.emplace_back(new FixedAllocator(block_size_, blocks_per_slab_, options_));
+        is_available_.push_back(true);
+    }
+    available_.push_back(slab);
+    ++num_slabs_;
+    
+    // Keep ranges_ sorted by base address for find_slab()
+    SlabRange range = {reinterpret_cast<uintptr_t>(slabs_[slab]->get_pool_base()), slab};
+    auto pos = std::upper_bound(ranges_.begin(), ranges_.end(), range.base,
+                                [](uintptr_t base, const SlabRange& r) { return base < r.base; });
+    ranges_.insert(pos, range);
+    return slab;
+}
+
+void GrowableFixedAllocator::release_slab(size_t slab) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(slabs_[slab]->get_pool_base());
+    ranges_.erase(std::find_if(ranges_.begin(), ranges_.end(),
+                               [base](const SlabRange& r) { return r.base == base; }));
+    if (is_available_[slab]) {
+        available_.erase(std::find(available_.begin(), available_.end(), slab));
+        is_available_[slab] = false;
+    }
+    slabs_[slab].reset();
+    free_slots_.push_back(slab);
+    --num_slabs_;
+}
+
+size_t GrowableFixedAllocator::find_slab(void* ptr) const {
+    // Last slab starting at or below ptr, then check ptr is inside it
+    uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    auto pos = std::upper_bound(ranges_.begin(), ranges_.end(), address,
+                                [](uintptr_t a, const SlabRange& r) { return a < r.base; });
+    if (pos == ranges_.begin()) {
+        return slabs_.size();
+    }
+    --pos;
+    const FixedAllocator& pool = *slabs_[pos->slab];
+    if (address - pos->base >= pool.get_pool_size()) {
+        return slabs_.size();
+    }
+    return pos->slab;
+}
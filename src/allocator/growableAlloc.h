@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "fixAlloc.h"
+
+/**
+ * Fixed-size allocator that grows by chaining slabs instead of failing.
+ *
+ * Each slab is a FixedAllocator of blocks_per_slab blocks with its own
+ * bitmap. Slabs that still have a free block sit on an available list, so
+ * allocate() never looks at a full slab; when the list is empty a new slab
+ * is added (up to max_slabs, 0 = unlimited). deallocate() finds the owning
+ * slab by binary search over the slab base addresses.
+ *
+ * trim() destroys slabs with no live blocks, except one kept so a load
+ * that keeps crossing a slab boundary doesn't destroy and recreate it, and
+ * trims the free pages of the rest; options.auto_trim_bytes runs it
+ * automatically.
+ */
+class GrowableFixedAllocator {
+public:
+    GrowableFixedAllocator(size_t block_size, size_t blocks_per_slab, size_t max_slabs = 0,
+                           const FixedAllocatorOptions& options = FixedAllocatorOptions());
+    
+    // Delete copy constructor and assignment operator
+    GrowableFixedAllocator(const GrowableFixedAllocator&) = delete;
+    GrowableFixedAllocator& operator=(const GrowableFixedAllocator&) = delete;
+    
+    void* allocate();
+    bool deallocate(void* ptr);
+    bool is_valid_pointer(void* ptr) const;
+    
+    // Release all but one empty slab and the free pages of the others.
+    // Returns the number of bytes given back to the OS.
+    size_t trim();
+    
+    // Statistics methods
+    size_t get_block_size() const { return block_size_; }
+    size_t get_blocks_per_slab() const { return blocks_per_slab_; }
+    size_t get_num_slabs() const { return num_slabs_; }
+    size_t get_total_blocks() const { return num_slabs_ * blocks_per_slab_; }
+    size_t get_free_blocks() const;
+    size_t get_used_blocks() const { return used_blocks_; }
+    bool is_empty() const { return used_blocks_ == 0; }
+
+private:
+    // Slab base address, for owner lookup
+    struct SlabRange {
+        uintptr_t base;
+        size_t slab;
+    };
+    
+    // Helper methods
+    size_t add_slab();
+    void release_slab(size_t slab);
+    size_t find_slab(void* ptr) const;
+    
+    // Member variables
+    size_t block_size_;                  // Rounded up to the alignment, as in every slab
+    size_t blocks_per_slab_;
+    size_t max_slabs_;
+    size_t num_slabs_;
+    size_t used_blocks_;
+    size_t auto_trim_bytes_;
+    size_t freed_since_trim_;            // Bytes freed since the last trim()
+    FixedAllocatorOptions options_;
+    std::vector<std::unique_ptr<FixedAllocator>> slabs_;  // nullptr = released slot
+    std::vector<size_t> free_slots_;     // Released slots to reuse
+    std::vector<SlabRange> ranges_;      // Sorted by base address
+    std::vector<size_t> available_;      // Slabs with at least one free block
+    std::vector<bool> is_available_;     // Per slab: currently on available_
+};
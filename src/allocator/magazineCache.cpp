@@ -0,0 +1,149 @@
+#include "magazineCache.h"
+#include "allocDiagnostics.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Return every cached block in a magazine to its central pool
+void drain(Magazine& magazine) {
+    if (magazine.count != 0) {
+        magazine.central->deallocate_bulk(magazine.slots.get(), magazine.count);
+        magazine.count = 0;
+    }
+}
+
+// All magazines owned by one thread; flushed when the thread exits
+struct ThreadMagazines {
+    std::vector<std::unique_ptr<Magazine>> magazines;
+    
+    ~ThreadMagazines();
+};
+
+thread_local ThreadMagazines tls_magazines;
+thread_local Magazine* tls_last_magazine = nullptr;  // One-entry lookup cache
+thread_local bool tls_magazines_destroyed = false;   // Trivial, so still readable during teardown
+
+ThreadMagazines::~ThreadMagazines() {
+    for (auto& magazine : magazines) {
+        drain(*magazine);
+    }
+    tls_last_magazine = nullptr;
+    tls_magazines_destroyed = true;
+}
+
+std::atomic<uint64_t> next_allocator_id{1};
+
+}  // namespace
+
+ThreadCachedAllocator::ThreadCachedAllocator(size_t block_size, size_t num_blocks, size_t magazine_size)
+    : central_(std::make_shared<ConcurrentFixedAllocator>(block_size, num_blocks))
+    , magazine_size_(magazine_size)
+    , batch_size_(std::max<size_t>(1, magazine_size / 2))
+    , id_(next_allocator_id.fetch_add(1, std::memory_order_relaxed))
+{
+    if (magazine_size == 0) {
+        throw std::invalid_argument("Magazine size must be > 0");
+    }
+}
+
+ThreadCachedAllocator::~ThreadCachedAllocator() {
+    // Drop the calling thread's magazine now; other threads return theirs
+    // when they exit, and the last one releases the central pool
+    if (tls_magazines_destroyed) {
+        return;  // Thread teardown already flushed it (e.g. a global destroyed after main's TLS)
+    }
+    auto& magazines = tls_magazines.magazines;
+    for (auto it = magazines.begin(); it != magazines.end(); ++it) {
+        if ((*it)->owner_id == id_) {
+            drain(**it);
+            if (tls_last_magazine == it->get()) {
+                tls_last_magazine = nullptr;
+            }
+            magazines.erase(it);
+            break;
+        }
+    }
+}
+
+void* ThreadCachedAllocator::allocate() {
+    Magazine& magazine = thread_magazine();
+    if (magazine.count == 0) {
+        // Refill half a magazine so the next few frees don't flush right away
+        magazine.count = central_->allocate_bulk(magazine.slots.get(), batch_size_);
+        if (magazine.count == 0) {
+            return nullptr;  // Central pool exhausted
+        }
+    }
+    return magazine.slots[--magazine.count];
+}
+
+bool ThreadCachedAllocator::deallocate(void* ptr) {
+    if (!central_->is_valid_pointer(ptr)) {
+        diag_event(DiagEvent::InvalidPointer, ptr);
+        return false;  // Invalid pointer
+    }
+    
+    Magazine& magazine = thread_magazine();
+    if (magazine.count == magazine.capacity) {
+        // Flush the oldest blocks in one batch and slide the rest down
+        central_->deallocate_bulk(magazine.slots.get(), batch_size_);
+        magazine.count -= batch_size_;
+        std::memmove(magazine.slots.get(), magazine.slots.get() + batch_size_,
+                     magazine.count * sizeof(void*));
+    }
+    magazine.slots[magazine.count++] = ptr;
+    return true;
+}
+
+bool ThreadCachedAllocator::is_valid_pointer(void* ptr) const {
+    return central_->is_valid_pointer(ptr);
+}
+
+void ThreadCachedAllocator::flush_thread_cache() {
+    drain(thread_magazine());
+}
+
+size_t ThreadCachedAllocator::get_thread_cached_blocks() {
+    return thread_magazine().count;
+}
+
+Magazine& ThreadCachedAllocator::thread_magazine() {
+    if (tls_last_magazine && tls_last_magazine->owner_id == id_) {
+        return *tls_last_magazine;
+    }
+    
+    auto& magazines = tls_magazines.magazines;
+    for (auto& magazine : magazines) {
+        if (magazine->owner_id == id_) {
+            tls_last_magazine = magazine.get();
+            return *magazine;
+        }
+    }
+    
+    // First use from this thread. Drop magazines whose allocator is gone and
+    // that no other thread still references before adding a new one: return
+    // their blocks first, then erase them.
+    auto orphaned = [](const std::unique_ptr<Magazine>& magazine) {
+        return magazine->central.use_count() == 1;
+    };
+    for (auto& magazine : magazines) {
+        if (orphaned(magazine)) {
+            drain(*magazine);
+        }
+    }
+    magazines.erase(std::remove_if(magazines.begin(), magazines.end(), orphaned), magazines.end());
+    
+    std::unique_ptr<Magazine> magazine(new Magazine());
+    magazine->central = central_;
+    magazine->slots.reset(new void*[magazine_size_]);
+    magazine->capacity = magazine_size_;
+    magazine->owner_id = id_;
+    magazines.push_back(std::move(magazine));
+    
+    tls_last_magazine = magazines.back().get();
+    return *tls_last_magazine;
+}
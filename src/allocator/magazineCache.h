@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "concurrentAlloc.h"
+
+/**
+ * Per-thread magazine caches in front of a shared ConcurrentFixedAllocator.
+ *
+ * Each thread keeps a small stack of block pointers (a magazine) per
+ * allocator. allocate() and deallocate() only touch the calling thread's
+ * magazine, with no atomics; an empty magazine is refilled and a full one
+ * is half-flushed with a single batch call to the central pool. When a
+ * thread exits, its cached blocks are returned to the central pool.
+ *
+ * Blocks sitting in a magazine count as used in the central pool, and a
+ * block freed twice while cached is not detected.
+ */
+
+// One thread's cached blocks for one ThreadCachedAllocator
+struct Magazine {
+    std::shared_ptr<ConcurrentFixedAllocator> central;  // Keeps the pool alive until flushed
+    std::unique_ptr<void*[]> slots;
+    size_t count = 0;
+    size_t capacity = 0;
+    uint64_t owner_id = 0;
+};
+
+class ThreadCachedAllocator {
+public:
+    ThreadCachedAllocator(size_t block_size, size_t num_blocks, size_t magazine_size = 64);
+    ~ThreadCachedAllocator();
+    
+    // Delete copy constructor and assignment operator
+    ThreadCachedAllocator(const ThreadCachedAllocator&) = delete;
+    ThreadCachedAllocator& operator=(const ThreadCachedAllocator&) = delete;
+    
+    void* allocate();
+    bool deallocate(void* ptr);
+    bool is_valid_pointer(void* ptr) const;
+    
+    // Return the calling thread's cached blocks to the central pool now
+    void flush_thread_cache();
+    
+    // Statistics methods
+    size_t get_block_size() const { return central_->get_block_size(); }
+    size_t get_total_blocks() const { return central_->get_total_blocks(); }
+    size_t get_magazine_size() const { return magazine_size_; }
+    size_t get_thread_cached_blocks();
+    size_t get_central_free_blocks() const { return central_->get_free_blocks(); }
+
+private:
+    Magazine& thread_magazine();
+    
+    // Member variables
+    std::shared_ptr<ConcurrentFixedAllocator> central_;
+    size_t magazine_size_;
+    size_t batch_size_;  // Blocks moved per refill/flush
+    uint64_t id_;        // Unique per instance; addresses can be reused, ids are not
+};
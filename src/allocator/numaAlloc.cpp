@@ -0,0 +1,159 @@
+#include "numaAlloc.h"
+#include "allocDiagnostics.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+// Parse a kernel node list such as "0", "0-1" or "0-3,6"
+std::vector<int> parse_node_list(const std::string& list) {
+    std::vector<int> nodes;
+    std::stringstream ranges(list);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        size_t dash = range.find('-');
+        try {
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int node = first; node <= last; ++node) {
+                nodes.push_back(node);
+            }
+        } catch (const std::exception&) {
+            return {};  // Unexpected format
+        }
+    }
+    return nodes;
+}
+
+// Nodes that have memory, in ascending order. Empty if unknown.
+std::vector<int> memory_nodes() {
+    for (const char* path : {"/sys/devices/system/node/has_memory",
+                             "/sys/devices/system/node/online"}) {
+        std::ifstream file(path);
+        std::string list;
+        if (file >> list) {
+            return parse_node_list(list);
+        }
+    }
+    return {};
+}
+
+}  // namespace
+
+NumaFixedAllocator::NumaFixedAllocator(size_t block_size, size_t blocks_per_node,
+                                       const FixedAllocatorOptions& options)
+{
+    nodes_ = memory_nodes();
+    bool numa = nodes_.size() > 1;
+    if (!numa) {
+        nodes_.assign(1, 0);  // Single pool, default memory policy
+    }
+    
+    FixedAllocatorOptions pool_options = options;
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        pool_options.numa_node = numa ? nodes_[i] : -1;
+        pools_.push_back(std::make_unique<ConcurrentFixedAllocator>(block_size, blocks_per_node,
+                                                                    pool_options));
+        if (numa && pools_.back()->get_numa_node() != nodes_[i]) {
+            diag_event(DiagEvent::NumaBindFailed, nullptr, static_cast<size_t>(nodes_[i]));
+        }
+        if (static_cast<size_t>(nodes_[i]) >= node_to_pool_.size()) {
+            node_to_pool_.resize(nodes_[i] + 1, -1);
+        }
+        node_to_pool_[nodes_[i]] = static_cast<int>(i);
+    }
+}
+
+void* NumaFixedAllocator::allocate() {
+    // Local node first; CPUs on memoryless or unknown nodes start at pool 0
+    int local = pools_.size() > 1 ? pool_index(current_node()) : 0;
+    size_t start = local < 0 ? 0 : static_cast<size_t>(local);
+    for (size_t i = 0; i < pools_.size(); ++i) {
+        if (void* ptr = pools_[(start + i) % pools_.size()]->allocate()) {
+            return ptr;
+        }
+    }
+    return nullptr;  // Every node is full
+}
+
+void* NumaFixedAllocator::allocate_on_node(int node) {
+    int index = pool_index(node);
+    return index < 0 ? nullptr : pools_[index]->allocate();
+}
+
+bool NumaFixedAllocator::deallocate(void* ptr) {
+    for (auto& pool : pools_) {
+        if (pool->is_valid_pointer(ptr)) {
+            return pool->deallocate(ptr);
+        }
+    }
+    diag_event(DiagEvent::InvalidPointer, ptr);
+    return false;
+}
+
+bool NumaFixedAllocator::is_valid_pointer(void* ptr) const {
+    return node_of(ptr) >= 0;
+}
+
+int NumaFixedAllocator::node_of(void* ptr) const {
+    for (size_t i = 0; i < pools_.size(); ++i) {
+        if (pools_[i]->is_valid_pointer(ptr)) {
+            return nodes_[i];
+        }
+    }
+    return -1;
+}
+
+int NumaFixedAllocator::current_node() {
+#if defined(__linux__) && defined(SYS_getcpu)
+    // Raw syscall: the getcpu() wrapper is glibc-only (2.29+)
+    unsigned int cpu = 0;
+    unsigned int node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return -1;
+    }
+    return static_cast<int>(node);
+#else
+    return -1;  // No way to ask; allocate() starts at the first pool
+#endif
+}
+
+bool NumaFixedAllocator::is_bound() const {
+    for (size_t i = 0; i < pools_.size(); ++i) {
+        if (pools_[i]->get_numa_node() != nodes_[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t NumaFixedAllocator::get_total_blocks() const {
+    size_t total = 0;
+    for (const auto& pool : pools_) {
+        total += pool->get_total_blocks();
+    }
+    return total;
+}
+
+size_t NumaFixedAllocator::get_free_blocks() const {
+    size_t free_blocks = 0;
+    for (const auto& pool : pools_) {
+        free_blocks += pool->get_free_blocks();
+    }
+    return free_blocks;
+}
+
+size_t NumaFixedAllocator::get_free_blocks_on_node(int node) const {
+    int index = pool_index(node);
+    return index < 0 ? 0 : pools_[index]->get_free_blocks();
+}
+
+int NumaFixedAllocator::pool_index(int node) const {
+    if (node < 0 || static_cast<size_t>(node) >= node_to_pool_.size()) {
+        return -1;
+    }
+    return node_to_pool_[node];
+}
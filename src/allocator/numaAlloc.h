@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "concurrentAlloc.h"
+
+/**
+ * NUMA-aware front end: one ConcurrentFixedAllocator per memory node, with
+ * each pool's pages bound to its node (mbind) before they are first touched.
+ *
+ * allocate() asks getcpu() which node the calling thread is running on and
+ * serves the block from that node's pool, spilling over to the other nodes
+ * in order when it is exhausted. deallocate() returns a block to the pool
+ * that owns it, whichever thread frees it.
+ *
+ * Nodes come from /sys/devices/system/node/has_memory. On a single-node
+ * machine (or when the list can't be read) there is exactly one pool and
+ * nothing is bound, so the allocator behaves like a plain
+ * ConcurrentFixedAllocator. Outside Linux the calling thread's node is
+ * unknown and allocate() starts at the first pool.
+ */
+class NumaFixedAllocator {
+public:
+    // blocks_per_node blocks in every node's pool. options.numa_node is
+    // ignored; every other option is passed to each pool.
+    NumaFixedAllocator(size_t block_size, size_t blocks_per_node,
+                       const FixedAllocatorOptions& options = FixedAllocatorOptions());
+    
+    // Delete copy constructor and assignment operator
+    NumaFixedAllocator(const NumaFixedAllocator&) = delete;
+    NumaFixedAllocator& operator=(const NumaFixedAllocator&) = delete;
+    
+    void* allocate();
+    void* allocate_on_node(int node);  // That node's pool only; nullptr if full or unknown
+    bool deallocate(void* ptr);
+    bool is_valid_pointer(void* ptr) const;
+    
+    // Node whose pool holds ptr, -1 if ptr is not from this allocator
+    int node_of(void* ptr) const;
+    
+    // Node of the CPU the calling thread is running on, -1 if unknown
+    static int current_node();
+    
+    // Statistics methods
+    size_t get_num_nodes() const { return pools_.size(); }
+    const std::vector<int>& get_nodes() const { return nodes_; }
+    bool is_bound() const;  // True if every pool's pages are bound to its node
+    size_t get_block_size() const { return pools_.front()->get_block_size(); }
+    size_t get_total_blocks() const;
+    size_t get_free_blocks() const;
+    size_t get_free_blocks_on_node(int node) const;
+
+private:
+    // Index into pools_ for a node id, -1 if the node has no pool
+    int pool_index(int node) const;
+    
+    // Member variables
+    std::vector<std::unique_ptr<ConcurrentFixedAllocator>> pools_;
+    std::vector<int> nodes_;         // Node id of each pool
+    std::vector<int> node_to_pool_;  // Node id -> index into pools_, -1 = none
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include "fixAlloc.h"
+
+template <typename T>
+class ObjectPool;
+
+// Destroys the object and returns its block to the pool it came from.
+// One pointer wide, so a pooled_ptr is two pointers and never allocates.
+template <typename T>
+struct PoolDeleter {
+    ObjectPool<T>* pool = nullptr;
+
+    void operator()(T* ptr) const { pool->destroy(ptr); }
+};
+
+template <typename T>
+using pooled_ptr = std::unique_ptr<T, PoolDeleter<T>>;
+
+/**
+ * Typed pool of T objects over a FixedAllocator: blocks are sizeof(T) and
+ * aligned to at least alignof(T), so over-aligned types work.
+ *
+ * emplace() constructs a T in a free block and hands it out as a
+ * pooled_ptr that destroys it and frees the block when it goes out of
+ * scope; create()/destroy() are the raw-pointer equivalents. The pool must
+ * outlive every object taken from it. Not thread-safe.
+ */
+template <typename T>
+class ObjectPool {
+public:
+    explicit ObjectPool(size_t capacity, const FixedAllocatorOptions& options = FixedAllocatorOptions())
+        : pool_(sizeof(T), capacity, with_alignment(options))
+    {
+    }
+
+    // Delete copy constructor and assignment operator
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // Empty pooled_ptr if the pool is full; exceptions from T's
+    // constructor propagate after the block is returned
+    template <typename... Args>
+    pooled_ptr<T> emplace(Args&&... args) {
+        return pooled_ptr<T>(create(std::forward<Args>(args)...), PoolDeleter<T>{this});
+    }
+
+    // nullptr if the pool is full
+    template <typename... Args>
+    T* create(Args&&... args) {
+        void* block = pool_.allocate();
+        if (!block) {
+            return nullptr;
+        }
+        try {
+            return ::new (block) T(std::forward<Args>(args)...);
+        } catch (...) {
+            pool_.deallocate(block);
+            throw;
+        }
+    }
+
+    void destroy(T* ptr) {
+        if (!ptr) {
+            return;
+        }
+        ptr->~T();
+        pool_.deallocate(ptr);
+    }
+
+    bool owns(const T* ptr) const { return pool_.is_valid_pointer(const_cast<T*>(ptr)); }
+
+    // Statistics methods
+    size_t get_capacity() const { return pool_.get_total_blocks(); }
+    size_t get_live_objects() const { return pool_.get_used_blocks(); }
+    size_t get_free_slots() const { return pool_.get_free_blocks(); }
+    bool is_full() const { return pool_.is_full(); }
+    bool is_empty() const { return pool_.is_empty(); }
+
+private:
+    static FixedAllocatorOptions with_alignment(FixedAllocatorOptions options) {
+        options.alignment = std::max(options.alignment, alignof(T));
+        return options;
+    }
+
+    // Member variables
+    FixedAllocator pool_;
+};
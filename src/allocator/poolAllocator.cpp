@@ -0,0 +1,37 @@
+#include "poolAllocator.h"
+#include <algorithm>
+
+PoolAllocatorPools::PoolAllocatorPools(size_t blocks_per_slab, const FixedAllocatorOptions& options)
+    : blocks_per_slab_(blocks_per_slab)
+    , options_(options)
+{
+}
+
+GrowableFixedAllocator& PoolAllocatorPools::pool_for(size_t size, size_t alignment) {
+    for (Entry& entry : pools_) {
+        if (entry.size == size && entry.alignment == alignment) {
+            return *entry.pool;
+        }
+    }
+    
+    FixedAllocatorOptions options = options_;
+    options.alignment = std::max(options.alignment, alignment);
+    pools_.push_back(Entry{size, alignment,
+        std::make_unique<GrowableFixedAllocator>(size, blocks_per_slab_, 0, options)});
+    return *pools_.back().pool;
+}
+
+size_t PoolAllocatorPools::get_used_blocks() const {
+    size_t used = 0;
+    for (const Entry& entry : pools_) {
+        used += entry.pool->get_used_blocks();
+    }
+    return used;
+}
+
+FixedAllocatorOptions PoolAllocatorPools::default_options() {
+    FixedAllocatorOptions options;
+    options.mode = AllocationMode::FreeList;
+    options.detect_double_free = false;
+    return options;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "growableAlloc.h"
+
+/**
+ * Pools shared by a family of PoolAllocator<T>: one GrowableFixedAllocator
+ * per (size, alignment), created the first time a rebound allocator needs
+ * it. Like FixedAllocator, not thread-safe.
+ */
+class PoolAllocatorPools {
+public:
+    // Pool geometry for every size; blocks_per_slab blocks per slab
+    explicit PoolAllocatorPools(size_t blocks_per_slab = 4096,
+                                const FixedAllocatorOptions& options = default_options());
+    
+    // Delete copy constructor and assignment operator
+    PoolAllocatorPools(const PoolAllocatorPools&) = delete;
+    PoolAllocatorPools& operator=(const PoolAllocatorPools&) = delete;
+    
+    GrowableFixedAllocator& pool_for(size_t size, size_t alignment);
+    
+    // Statistics methods
+    size_t get_num_pools() const { return pools_.size(); }
+    size_t get_used_blocks() const;
+    
+    // FreeList mode without double-free checks: O(1) node churn
+    static FixedAllocatorOptions default_options();
+
+private:
+    struct Entry {
+        size_t size;
+        size_t alignment;
+        std::unique_ptr<GrowableFixedAllocator> pool;
+    };
+    
+    // Member variables
+    size_t blocks_per_slab_;
+    FixedAllocatorOptions options_;
+    std::vector<Entry> pools_;  // A handful of node sizes; searched linearly
+};
+
+/**
+ * Standard Allocator for node-based containers (std::list, std::map,
+ * std::set, std::unordered_map, ...). Single-object allocations come from
+ * the pool for sizeof(T); array allocations such as hash bucket tables go
+ * to std::allocator.
+ *
+ * Allocators rebound from each other share one PoolAllocatorPools and
+ * compare equal; a default-constructed allocator gets its own. The pools
+ * propagate with the container on copy, move and swap.
+ */
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+    
+    template <typename U>
+    struct rebind {
+        using other = PoolAllocator<U>;
+    };
+    
+    PoolAllocator() : pools_(std::make_shared<PoolAllocatorPools>()), pool_(nullptr) {}
+    explicit PoolAllocator(std::shared_ptr<PoolAllocatorPools> pools)
+        : pools_(std::move(pools)), pool_(nullptr) {}
+    
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pools_(other.pools_), pool_(nullptr) {}
+    
+    // Moves copy: a moved-from allocator must stay usable and equal to the
+    // one it was moved into, so both keep sharing the pools
+    PoolAllocator(const PoolAllocator& other) noexcept : pools_(other.pools_), pool_(nullptr) {}
+    PoolAllocator(PoolAllocator&& other) noexcept : pools_(other.pools_), pool_(nullptr) {}
+    PoolAllocator& operator=(const PoolAllocator& other) noexcept {
+        pools_ = other.pools_;
+        pool_ = nullptr;
+        return *this;
+    }
+    PoolAllocator& operator=(PoolAllocator&& other) noexcept {
+        return *this = static_cast<const PoolAllocator&>(other);
+    }
+    
+    T* allocate(size_t n) {
+        if (n != 1) {
+            return std::allocator<T>().allocate(n);
+        }
+        void* ptr = pool().allocate();
+        if (!ptr) {
+            throw std::bad_alloc();  // Slab limit reached
+        }
+        return static_cast<T*>(ptr);
+    }
+    
+    void deallocate(T* ptr, size_t n) {
+        if (n != 1) {
+            std::allocator<T>().deallocate(ptr, n);
+            return;
+        }
+        pool().deallocate(ptr);
+    }
+    
+    const std::shared_ptr<PoolAllocatorPools>& get_pools() const { return pools_; }
+    
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const { return pools_ == other.pools_; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const { return pools_ != other.pools_; }
+
+private:
+    template <typename U>
+    friend class PoolAllocator;
+    
+    // This type's pool, looked up once per allocator object
+    GrowableFixedAllocator& pool() {
+        if (!pool_) {
+            pool_ = &pools_->pool_for(sizeof(T), alignof(T));
+        }
+        return *pool_;
+    }
+    
+    // Member variables
+    std::shared_ptr<PoolAllocatorPools> pools_;
+    GrowableFixedAllocator* pool_;  // Cached pools_->pool_for(sizeof(T), alignof(T))
+};
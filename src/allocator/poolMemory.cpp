@@ -0,0 +1,205 @@
+#include "poolMemory.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+#ifndef MPOL_BIND
+#define MPOL_BIND 2  // From <numaif.h>, without linking libnuma
+#endif
+
+namespace {
+
+const size_t kHugePage2M = size_t(2) << 20;
+const size_t kHugePage1G = size_t(1) << 30;
+const size_t kCommitChunk = kHugePage2M;  // Keeps THP-backed commits in whole huge pages
+
+size_t round_up(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+size_t base_page_size() {
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return page_size;
+}
+
+// Anonymous mapping of size bytes whose start is a multiple of alignment.
+// Over-maps by alignment and unmaps the unused head and tail. A reserved
+// mapping is inaccessible and uncharged until commit_pool_region().
+bool map_aligned(PoolRegion& region, size_t size, size_t alignment, bool reserve_only) {
+    size_t page = base_page_size();
+    size_t length = round_up(size, page);
+    size_t slack = alignment > page ? alignment : 0;
+    int prot = reserve_only ? PROT_NONE : PROT_READ | PROT_WRITE;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | (reserve_only ? MAP_NORESERVE : 0);
+    void* raw = mmap(nullptr, length + slack, prot, flags, -1, 0);
+    if (raw == MAP_FAILED) {
+        return false;
+    }
+    
+    uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned = slack ? round_up(start, alignment) : start;
+    if (aligned > start) {
+        munmap(raw, aligned - start);
+    }
+    size_t tail = (start + length + slack) - (aligned + length);
+    if (tail > 0) {
+        munmap(reinterpret_cast<void*>(aligned + length), tail);
+    }
+    
+    region.base = reinterpret_cast<uint8_t*>(aligned);
+    region.size = size;
+    region.mapped_size = length;
+    region.page_size = page;
+    region.committed = reserve_only ? 0 : length;
+    return true;
+}
+
+bool map_huge_tlb(PoolRegion& region, size_t size, size_t huge_page, int log2_page) {
+#ifdef MAP_HUGETLB
+    size_t length = round_up(size, huge_page);
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (log2_page << MAP_HUGE_SHIFT);
+    void* raw = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (raw == MAP_FAILED) {
+        return false;  // No pages reserved in the hugetlb pool, or unsupported size
+    }
+    region.base = static_cast<uint8_t*>(raw);
+    region.size = size;
+    region.mapped_size = length;
+    region.page_size = huge_page;
+    region.committed = length;
+    return true;
+#else
+    (void)region; (void)size; (void)huge_page; (void)log2_page;
+    return false;
+#endif
+}
+
+// Restrict the region's pages to one node. Must run before the first touch.
+bool bind_to_node(const PoolRegion& region, int node) {
+#ifdef SYS_mbind
+    const size_t kBitsPerMask = sizeof(unsigned long) * 8;
+    unsigned long mask[4] = {};  // Up to 256 nodes
+    if (node < 0 || static_cast<size_t>(node) >= sizeof(mask) * 8) {
+        return false;
+    }
+    mask[node / kBitsPerMask] = 1UL << (node % kBitsPerMask);
+    return syscall(SYS_mbind, region.base, region.mapped_size, MPOL_BIND,
+                   mask, sizeof(mask) * 8, 0) == 0;
+#else
+    (void)region; (void)node;
+    return false;
+#endif
+}
+
+// Map size bytes with the requested backing, falling back as documented
+PoolRegion map_region(size_t size, size_t alignment, PoolBacking backing, bool reserve_only) {
+    PoolRegion region;
+    
+    switch (backing) {
+        case PoolBacking::HugeTLB1G:
+            if (map_huge_tlb(region, size, kHugePage1G, 30)) {
+                region.backing = PoolBacking::HugeTLB1G;
+                return region;
+            }
+            [[fallthrough]];  // Try 2 MB pages
+        case PoolBacking::HugeTLB2M:
+            if (alignment <= kHugePage2M && map_huge_tlb(region, size, kHugePage2M, 21)) {
+                region.backing = PoolBacking::HugeTLB2M;
+                return region;
+            }
+            [[fallthrough]];  // Try transparent huge pages
+        case PoolBacking::TransparentHugePages:
+            // 2 MB alignment lets the kernel back the region with whole huge pages
+            if (map_aligned(region, size, alignment > kHugePage2M ? alignment : kHugePage2M, reserve_only)) {
+#ifdef MADV_HUGEPAGE
+                if (madvise(region.base, region.mapped_size, MADV_HUGEPAGE) == 0) {
+                    region.backing = PoolBacking::TransparentHugePages;
+                    region.page_size = kHugePage2M;  // Trim whole huge pages, don't split them
+                    return region;
+                }
+#endif
+                region.backing = PoolBacking::Mmap;  // THP unavailable; keep the mapping
+                return region;
+            }
+            throw std::bad_alloc();
+        case PoolBacking::Mmap:
+            if (map_aligned(region, size, alignment, reserve_only)) {
+                region.backing = PoolBacking::Mmap;
+                return region;
+            }
+            throw std::bad_alloc();
+        case PoolBacking::Heap:
+            break;
+    }
+    
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, size) != 0) {
+        throw std::bad_alloc();
+    }
+    region.base = static_cast<uint8_t*>(ptr);
+    region.size = size;
+    region.page_size = base_page_size();
+    region.committed = size;
+    region.backing = PoolBacking::Heap;
+    return region;
+}
+
+}  // namespace
+
+const char* pool_backing_name(PoolBacking backing) {
+    switch (backing) {
+        case PoolBacking::Heap:                 return "heap";
+        case PoolBacking::Mmap:                 return "mmap";
+        case PoolBacking::TransparentHugePages: return "thp";
+        case PoolBacking::HugeTLB2M:            return "hugetlb-2M";
+        case PoolBacking::HugeTLB1G:            return "hugetlb-1G";
+    }
+    return "unknown";
+}
+
+PoolRegion allocate_pool_region(size_t size, size_t alignment, PoolBacking backing,
+                                bool reserve_only, int numa_node) {
+    if ((reserve_only || numa_node >= 0) && backing == PoolBacking::Heap) {
+        backing = PoolBacking::Mmap;
+    }
+    PoolRegion region = map_region(size, alignment, backing, reserve_only);
+    if (numa_node >= 0 && bind_to_node(region, numa_node)) {
+        region.numa_node = numa_node;
+    }
+    return region;
+}
+
+bool commit_pool_region(PoolRegion& region, size_t bytes) {
+    if (bytes <= region.committed) {
+        return true;
+    }
+    if (bytes > region.mapped_size) {
+        return false;
+    }
+    size_t target = std::min(round_up(bytes, kCommitChunk), region.mapped_size);
+    if (mprotect(region.base + region.committed, target - region.committed,
+                 PROT_READ | PROT_WRITE) != 0) {
+        return false;
+    }
+    region.committed = target;
+    return true;
+}
+
+void release_pool_region(PoolRegion& region) {
+    if (!region.base) {
+        return;
+    }
+    if (region.backing == PoolBacking::Heap) {
+        std::free(region.base);
+    } else {
+        munmap(region.base, region.mapped_size);
+    }
+    region = PoolRegion();
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Where an allocator's pool memory comes from
+enum class PoolBacking {
+    Heap,                  // posix_memalign
+    Mmap,                  // Anonymous mmap with base pages
+    TransparentHugePages,  // 2 MB-aligned anonymous mmap + madvise(MADV_HUGEPAGE)
+    HugeTLB2M,             // MAP_HUGETLB 2 MB pages, falls back to TransparentHugePages
+    HugeTLB1G              // MAP_HUGETLB 1 GB pages, falls back to HugeTLB2M
+};
+
+const char* pool_backing_name(PoolBacking backing);
+
+// A block of pool memory and how it was obtained
+struct PoolRegion {
+    uint8_t* base = nullptr;
+    size_t size = 0;          // Usable bytes starting at base
+    size_t mapped_size = 0;   // Bytes to unmap (mmap backings)
+    size_t page_size = 0;     // Granularity for madvise on this region
+    size_t committed = 0;     // Bytes from base that are readable and writable
+    PoolBacking backing = PoolBacking::Heap;  // What was actually used after fallbacks
+    int numa_node = -1;       // Node the pages are bound to, -1 if unbound
+};
+
+// Allocate size bytes aligned to alignment with the requested backing,
+// falling back along HugeTLB1G -> HugeTLB2M -> TransparentHugePages -> Mmap
+// when the system can't provide it. Throws std::bad_alloc on failure.
+//
+// reserve_only maps the address space PROT_NONE + MAP_NORESERVE and commits
+// nothing; grow the usable prefix with commit_pool_region(). Heap becomes
+// Mmap (the heap can't reserve), HugeTLB regions are committed up front.
+//
+// numa_node >= 0 binds the region to that node with mbind() before any page
+// is touched (Heap becomes Mmap here too). Binding is best effort: when the
+// kernel refuses, the region keeps the default policy and numa_node is -1.
+PoolRegion allocate_pool_region(size_t size, size_t alignment, PoolBacking backing,
+                                bool reserve_only = false, int numa_node = -1);
+
+// Make at least the first bytes of the region usable, in 2 MB steps.
+// Returns false if the kernel refused (the committed prefix is unchanged).
+bool commit_pool_region(PoolRegion& region, size_t bytes);
+
+// Return a region obtained from allocate_pool_region(); resets it to empty
+void release_pool_region(PoolRegion& region);
@@ -0,0 +1,32 @@
+#include "poolResource.h"
+
+FixedPoolResource::FixedPoolResource(size_t block_size, size_t num_blocks,
+                                     std::pmr::memory_resource* upstream,
+                                     const FixedAllocatorOptions& options)
+    : pool_(block_size, num_blocks, options)
+    , upstream_(upstream)
+    , upstream_allocations_(0)
+{
+}
+
+void* FixedPoolResource::do_allocate(size_t bytes, size_t alignment) {
+    if (bytes <= pool_.get_block_size() && alignment <= pool_.get_alignment()) {
+        if (void* ptr = pool_.allocate()) {
+            return ptr;
+        }
+    }
+    ++upstream_allocations_;
+    return upstream_->allocate(bytes, alignment);  // Throws if upstream can't serve it either
+}
+
+void FixedPoolResource::do_deallocate(void* ptr, size_t bytes, size_t alignment) {
+    if (pool_.is_valid_pointer(ptr)) {
+        pool_.deallocate(ptr);
+        return;
+    }
+    upstream_->deallocate(ptr, bytes, alignment);
+}
+
+bool FixedPoolResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include "fixAlloc.h"
+
+/**
+ * std::pmr::memory_resource backed by a FixedAllocator.
+ *
+ * Requests of at most get_block_size() bytes whose alignment the pool
+ * guarantees are served from the pool; larger or over-aligned requests,
+ * and any request made while the pool is full, go to the upstream
+ * resource. do_deallocate() tells the two apart by address. Two resources
+ * compare equal only if they are the same object. Not thread-safe, like
+ * std::pmr::unsynchronized_pool_resource.
+ */
+class FixedPoolResource : public std::pmr::memory_resource {
+public:
+    FixedPoolResource(size_t block_size, size_t num_blocks,
+                      std::pmr::memory_resource* upstream = std::pmr::get_default_resource(),
+                      const FixedAllocatorOptions& options = FixedAllocatorOptions());
+    
+    // Delete copy constructor and assignment operator
+    FixedPoolResource(const FixedPoolResource&) = delete;
+    FixedPoolResource& operator=(const FixedPoolResource&) = delete;
+    
+    // Statistics methods
+    std::pmr::memory_resource* upstream_resource() const { return upstream_; }
+    const FixedAllocator& get_pool() const { return pool_; }
+    size_t get_block_size() const { return pool_.get_block_size(); }
+    size_t get_upstream_allocations() const { return upstream_allocations_; }  // Since construction
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    // Member variables
+    FixedAllocator pool_;
+    std::pmr::memory_resource* upstream_;
+    size_t upstream_allocations_;
+};
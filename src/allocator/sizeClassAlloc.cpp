@@ -0,0 +1,116 @@
+#include "sizeClassAlloc.h"
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+
+std::vector<size_t> SizeClassConfig::default_class_sizes() {
+    std::vector<size_t> sizes = {8, 16, 32, 48, 64};
+    // Four evenly spaced classes per doubling: 80..128, 160..256, ... 3584..4096
+    for (size_t base = 64; base < 4096; base *= 2) {
+        for (size_t step = 1; step <= 4; ++step) {
+            sizes.push_back(base + step * base / 4);
+        }
+    }
+    return sizes;
+}
+
+SizeClassAllocator::SizeClassAllocator(const SizeClassConfig& config)
+    : max_size_(0)
+{
+    // Round to the lookup granularity, sort and drop duplicates
+    for (size_t size : config.class_sizes) {
+        if (size == 0) {
+            throw std::invalid_argument("Size classes must be > 0");
+        }
+        class_sizes_.push_back((size + kGranularity - 1) / kGranularity * kGranularity);
+    }
+    std::sort(class_sizes_.begin(), class_sizes_.end());
+    class_sizes_.erase(std::unique(class_sizes_.begin(), class_sizes_.end()), class_sizes_.end());
+    if (class_sizes_.empty() || class_sizes_.size() > UINT16_MAX) {
+        throw std::invalid_argument("Need between 1 and 65535 size classes");
+    }
+    max_size_ = class_sizes_.back();
+    
+    // One pool per class
+    for (size_t size : class_sizes_) {
+        size_t num_blocks = std::max<size_t>(1, config.bytes_per_class / size);
+        pools_.emplace_back(new FixedAllocator(size, num_blocks, config.pool_options));
+    }
+    requested_bytes_.assign(class_sizes_.size(), 0);
+    
+    // Lookup table: every 8-byte bucket maps to the smallest class covering it
+    class_lookup_.resize(max_size_ / kGranularity + 1);
+    size_t cls = 0;
+    for (size_t bucket = 0; bucket < class_lookup_.size(); ++bucket) {
+        while (class_sizes_[cls] < bucket * kGranularity) {
+            ++cls;
+        }
+        class_lookup_[bucket] = static_cast<uint16_t>(cls);
+    }
+}
+
+void* SizeClassAllocator::allocate(size_t size) {
+    if (size > max_size_) {
+        return nullptr;  // Larger than the biggest class
+    }
+    size_t index = class_index(size);
+    void* ptr = pools_[index]->allocate();
+    if (ptr) {
+        requested_bytes_[index] += size;
+    }
+    return ptr;
+}
+
+bool SizeClassAllocator::deallocate(void* ptr, size_t size) {
+    if (size > max_size_) {
+        return false;  // Could not have come from any class
+    }
+    size_t index = class_index(size);
+    if (!pools_[index]->deallocate(ptr)) {
+        return false;  // Invalid pointer, wrong size or double free
+    }
+    requested_bytes_[index] -= size;
+    return true;
+}
+
+size_t SizeClassAllocator::class_size_for(size_t size) const {
+    return size > max_size_ ? 0 : class_sizes_[class_index(size)];
+}
+
+std::vector<SizeClassStats> SizeClassAllocator::get_stats() const {
+    std::vector<SizeClassStats> stats;
+    stats.reserve(pools_.size());
+    for (size_t i = 0; i < pools_.size(); ++i) {
+        SizeClassStats s;
+        s.class_size = class_sizes_[i];
+        s.total_blocks = pools_[i]->get_total_blocks();
+        s.used_blocks = pools_[i]->get_used_blocks();
+        s.requested_bytes = requested_bytes_[i];
+        s.allocated_bytes = s.used_blocks * pools_[i]->get_block_size();  // After alignment rounding
+        s.internal_fragmentation = s.allocated_bytes == 0
+            ? 0.0
+            : 1.0 - static_cast<double>(s.requested_bytes) / static_cast<double>(s.allocated_bytes);
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+void SizeClassAllocator::print_stats(std::ostream& out) const {
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::setw(8) << "class" << std::setw(10) << "used"
+        << std::setw(10) << "total" << std::setw(14) << "requested"
+        << std::setw(14) << "allocated" << std::setw(10) << "waste" << '\n';
+    for (const SizeClassStats& s : get_stats()) {
+        if (s.used_blocks == 0) {
+            continue;
+        }
+        out << std::setw(8) << s.class_size << std::setw(10) << s.used_blocks
+            << std::setw(10) << s.total_blocks << std::setw(14) << s.requested_bytes
+            << std::setw(14) << s.allocated_bytes << std::setw(9) << std::fixed
+            << std::setprecision(1) << s.internal_fragmentation * 100 << "%\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+#include "fixAlloc.h"
+
+// Pool geometry for a SizeClassAllocator
+struct SizeClassConfig {
+    // Block sizes, rounded up to multiples of 8. Defaults to jemalloc-like
+    // spacing: 8, 16, 32, 48, 64, then four classes per doubling up to 4096.
+    std::vector<size_t> class_sizes = default_class_sizes();
+    
+    // Pool capacity per class; each class gets at least one block
+    size_t bytes_per_class = 1 << 20;
+    
+    // Passed to every per-class FixedAllocator
+    FixedAllocatorOptions pool_options;
+    
+    static std::vector<size_t> default_class_sizes();
+};
+
+// Per-class usage, including internal fragmentation
+struct SizeClassStats {
+    size_t class_size;
+    size_t total_blocks;
+    size_t used_blocks;
+    size_t requested_bytes;          // Sum of sizes callers asked for, live blocks only
+    size_t allocated_bytes;          // used_blocks * the pool's block size (class_size after alignment)
+    double internal_fragmentation;   // 1 - requested / allocated (0 when nothing is live)
+};
+
+/**
+ * Variable-size allocator built from one FixedAllocator per size class.
+ *
+ * allocate(size) serves the request from the smallest class that fits,
+ * found in constant time through a lookup table indexed by size / 8.
+ * Requests larger than the biggest class return nullptr. deallocate()
+ * needs the size that was passed to allocate().
+ */
+class SizeClassAllocator {
+public:
+    explicit SizeClassAllocator(const SizeClassConfig& config = SizeClassConfig());
+    
+    // Delete copy constructor and assignment operator
+    SizeClassAllocator(const SizeClassAllocator&) = delete;
+    SizeClassAllocator& operator=(const SizeClassAllocator&) = delete;
+    
+    void* allocate(size_t size);
+    bool deallocate(void* ptr, size_t size);
+    
+    // Statistics methods
+    size_t get_num_classes() const { return pools_.size(); }
+    size_t get_max_size() const { return max_size_; }
+    size_t class_size_for(size_t size) const;
+    std::vector<SizeClassStats> get_stats() const;
+    void print_stats(std::ostream& out) const;
+
+private:
+    static constexpr size_t kGranularity = 8;
+    
+    // Index into pools_ for size (size must be <= max_size_)
+    size_t class_index(size_t size) const { return class_lookup_[(size + kGranularity - 1) / kGranularity]; }
+    
+    // Member variables
+    size_t max_size_;
+    std::vector<std::unique_ptr<FixedAllocator>> pools_;
+    std::vector<size_t> class_sizes_;
+    std::vector<size_t> requested_bytes_;  // Per class, live allocations only
+    std::vector<uint16_t> class_lookup_;   // (size + 7) / 8 -> class index
+};
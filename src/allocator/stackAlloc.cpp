@@ -0,0 +1,103 @@
+#include "stackAlloc.h"
+#include "allocDiagnostics.h"
+#include <algorithm>
+#include <stdexcept>
+
+StackAllocator::StackAllocator(size_t capacity, PoolBacking backing, bool lazy_commit,
+                               bool check_lifo)
+    : cursor_(0)
+    , limit_(0)
+    , peak_(0)
+    , check_lifo_(check_lifo)
+{
+    if (capacity == 0) {
+        throw std::invalid_argument("Capacity must be > 0");
+    }
+    
+    region_ = allocate_pool_region(capacity, kDefaultAlignment, backing, lazy_commit);
+    cursor_ = base();
+    limit_ = base() + std::min(region_.committed, region_.size);
+}
+
+StackAllocator::~StackAllocator() {
+    release_pool_region(region_);
+}
+
+void* StackAllocator::allocate_slow(size_t size, size_t alignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        return nullptr;  // Not a power of two
+    }
+    
+    size_t top = get_used_bytes();
+    size_t start = ((cursor_ + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base();
+    if (start < top || start > region_.size || size > region_.size - start) {
+        return nullptr;  // Stack full (or the alignment wrapped around)
+    }
+    
+    // Lazy commit: extend the usable prefix to cover the block
+    uintptr_t end = base() + start + size;
+    if (end > limit_) {
+        if (!commit_pool_region(region_, start + size)) {
+            diag_event(DiagEvent::CommitFailed, nullptr, start + size);
+            return nullptr;
+        }
+        limit_ = base() + std::min(region_.committed, region_.size);
+    }
+    
+    if (check_lifo_) {
+        frames_.push_back(Frame{start, top});
+    }
+    cursor_ = end;
+    peak_ = std::max(peak_, start + size);
+    return region_.base + start;
+}
+
+bool StackAllocator::deallocate(void* ptr) {
+    size_t offset = reinterpret_cast<uintptr_t>(ptr) - base();
+    
+    if (check_lifo_) {
+        if (frames_.empty() || frames_.back().start != offset) {
+            diag_event(DiagEvent::LifoViolation, ptr, get_used_bytes());
+            return false;  // Not the newest live block
+        }
+        move_top(frames_.back().previous_top);
+        frames_.pop_back();
+        return true;
+    }
+    
+    // <=, not owns(): a zero-size block at the top starts at the top
+    if (offset > get_used_bytes()) {
+        diag_event(DiagEvent::InvalidPointer, ptr);
+        return false;  // Outside the live part of the stack
+    }
+    move_top(offset);
+    return true;
+}
+
+bool StackAllocator::rewind(Marker marker) {
+    size_t top = get_used_bytes();
+    if (marker.offset > top) {
+        diag_event(DiagEvent::LifoViolation, region_.base + marker.offset, top);
+        return false;  // Already released by an earlier rewind
+    }
+    
+    if (check_lifo_ && marker.offset != top) {
+        // The marker has to sit where the top was before some live block
+        auto first_released = std::lower_bound(
+            frames_.begin(), frames_.end(), marker.offset,
+            [](const Frame& frame, size_t offset) { return frame.previous_top < offset; });
+        if (first_released == frames_.end() || first_released->previous_top != marker.offset) {
+            diag_event(DiagEvent::LifoViolation, region_.base + marker.offset, top);
+            return false;  // Not a position marker() could have returned
+        }
+        frames_.erase(first_released, frames_.end());
+    }
+    
+    move_top(marker.offset);
+    return true;
+}
+
+void StackAllocator::move_top(size_t offset) {
+    peak_ = std::max(peak_, get_used_bytes());
+    cursor_ = base() + offset;
+}
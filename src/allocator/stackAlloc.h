@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "poolMemory.h"
+
+// LIFO checking is on by default in builds without NDEBUG
+#ifdef NDEBUG
+#define FIXALLOC_STACK_CHECK_LIFO false
+#else
+#define FIXALLOC_STACK_CHECK_LIFO true
+#endif
+
+/**
+ * Bump allocator for temporaries that are freed in strict LIFO order.
+ *
+ * allocate() rounds the top of the stack up to the requested alignment and
+ * bumps it. marker() records the top; rewind(marker) releases everything
+ * allocated after it at once, and deallocate() pops the newest block. The
+ * stack is one region obtained like a FixedAllocator pool
+ * (allocate_pool_region), so it can be huge-page backed, or reserved up
+ * front and committed in 2 MB steps as the top first reaches them.
+ *
+ * With check_lifo every allocation is recorded: freeing anything but the
+ * newest block, or rewinding to a marker that is stale (released by an
+ * earlier rewind) or was never taken, is reported as
+ * DiagEvent::LifoViolation and ignored. Without it deallocate() simply
+ * moves the top down to the pointer, and only rewinds above the top are
+ * caught. Not thread-safe.
+ */
+class StackAllocator {
+public:
+    static constexpr size_t kDefaultAlignment = alignof(std::max_align_t);
+
+    // Position of the stack top when marker() was called
+    struct Marker {
+        size_t offset;
+    };
+
+    explicit StackAllocator(size_t capacity, PoolBacking backing = PoolBacking::Heap,
+                            bool lazy_commit = false,
+                            bool check_lifo = FIXALLOC_STACK_CHECK_LIFO);
+    ~StackAllocator();
+
+    // Delete copy constructor and assignment operator
+    StackAllocator(const StackAllocator&) = delete;
+    StackAllocator& operator=(const StackAllocator&) = delete;
+
+    // alignment must be a power of two; nullptr when the stack is full
+    void* allocate(size_t size, size_t alignment = kDefaultAlignment) {
+        uintptr_t aligned = (cursor_ + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        if (!check_lifo_ && aligned <= limit_ && size <= limit_ - aligned) {
+            cursor_ = aligned + size;
+            return reinterpret_cast<void*>(aligned);
+        }
+        return allocate_slow(size, alignment);
+    }
+
+    // Pop the newest allocation
+    bool deallocate(void* ptr);
+
+    Marker marker() const { return Marker{get_used_bytes()}; }
+
+    // Release every allocation made since marker was taken
+    bool rewind(Marker marker);
+
+    // Release everything; committed memory is kept
+    void reset() { rewind(Marker{0}); }
+
+    bool owns(const void* ptr) const {
+        return reinterpret_cast<uintptr_t>(ptr) - base() < get_used_bytes();
+    }
+
+    // Statistics methods
+    size_t get_capacity() const { return region_.size; }
+    size_t get_used_bytes() const { return cursor_ - base(); }
+    size_t get_peak_bytes() const { return peak_ > get_used_bytes() ? peak_ : get_used_bytes(); }
+    size_t get_committed_bytes() const { return region_.committed; }
+    PoolBacking get_backing() const { return region_.backing; }
+    bool checks_lifo() const { return check_lifo_; }
+
+private:
+    // One live allocation, recorded with check_lifo
+    struct Frame {
+        size_t start;         // Offset of the block
+        size_t previous_top;  // Offset of the top before it, i.e. before its padding
+    };
+
+    // Helper methods
+    uintptr_t base() const { return reinterpret_cast<uintptr_t>(region_.base); }
+    void* allocate_slow(size_t size, size_t alignment);
+    void move_top(size_t offset);
+
+    // Member variables
+    PoolRegion region_;
+    uintptr_t cursor_;           // First free byte
+    uintptr_t limit_;            // End of the committed prefix (capped at the capacity)
+    size_t peak_;                // Highest top seen by the slow path, rewind and deallocate
+    bool check_lifo_;
+    std::vector<Frame> frames_;  // Live allocations, oldest first (check_lifo only)
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "allocDiagnostics.h"
+#include "bitScan.h"
+
+// constinit where the language has it (C++20), otherwise the compiler
+// extension that checks the same thing, otherwise nothing: GCC in C++17
+// does not check, and a global is constant-initialized only because the
+// constructor is constexpr
+#if defined(__cpp_constinit)
+#define FIXALLOC_CONSTINIT constinit
+#elif defined(__clang__)
+#define FIXALLOC_CONSTINIT [[clang::require_constant_initialization]]
+#else
+#define FIXALLOC_CONSTINIT
+#endif
+
+/**
+ * FixedAllocator with its geometry fixed at compile time.
+ *
+ * The pool lives inside the object (alignas-ed storage) and the bitmap is
+ * a std::array of words, so there is no heap allocation or pointer chase,
+ * and block size / count are constants: index <-> pointer conversions
+ * compile to shifts or multiplies instead of divisions. The constructor is
+ * constexpr, so a global can be constant-initialized (FIXALLOC_CONSTINIT)
+ * and is ready before any dynamic initializer runs.
+ *
+ * Bitmap, first fit: the scan starts at the lowest word that may have a
+ * free block. The initial state is all zeros, so a global instance lands
+ * in .bss rather than taking pool-sized room in the binary. Not
+ * thread-safe.
+ */
+template <size_t BlockSize, size_t NumBlocks, size_t Alignment = sizeof(void*)>
+class StaticFixedAllocator {
+    static_assert(BlockSize > 0 && NumBlocks > 0, "Block size and number of blocks must be > 0");
+    static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0,
+                  "Alignment must be a power of two");
+
+public:
+    static constexpr size_t kAlignment = Alignment < sizeof(void*) ? sizeof(void*) : Alignment;
+    static constexpr size_t kBlockSize = (BlockSize + kAlignment - 1) & ~(kAlignment - 1);
+    static constexpr size_t kNumBlocks = NumBlocks;
+    static constexpr size_t kPoolSize = kBlockSize * kNumBlocks;
+
+    constexpr StaticFixedAllocator()
+        : storage_{}
+        , bitmap_{}
+        , used_blocks_count_(0)
+        , search_hint_(0)
+    {
+    }
+
+    // Delete copy constructor and assignment operator
+    StaticFixedAllocator(const StaticFixedAllocator&) = delete;
+    StaticFixedAllocator& operator=(const StaticFixedAllocator&) = delete;
+
+    void* allocate() {
+        // Usually the hint word has a free bit; otherwise skip full words
+        // with the vector scan
+        size_t word = search_hint_;
+        if (word < kWords && bitmap_[word] == kFullWord) {
+            word += find_first_word_not_equal(bitmap_.data() + word, kWords - word, kFullWord);
+            search_hint_ = word;
+        }
+        if (word == kWords) {
+            return nullptr;  // No free blocks available
+        }
+
+        uint64_t free_bits = ~bitmap_[word];
+        size_t index = word * kBitsPerWord + static_cast<size_t>(__builtin_ctzll(free_bits));
+        if (NumBlocks % kBitsPerWord != 0 && index >= NumBlocks) {
+            return nullptr;  // Only the unused tail of the last word is left
+        }
+        bitmap_[word] |= free_bits & (0 - free_bits);  // Claim the lowest free bit
+        ++used_blocks_count_;
+        return storage_ + index * kBlockSize;
+    }
+
+    bool deallocate(void* ptr) {
+        if (!is_valid_pointer(ptr)) {
+            diag_event(DiagEvent::InvalidPointer, ptr);
+            return false;  // Invalid pointer
+        }
+
+        size_t index = static_cast<size_t>(static_cast<unsigned char*>(ptr) - storage_) / kBlockSize;
+        uint64_t bit = uint64_t(1) << (index % kBitsPerWord);
+        size_t word = index / kBitsPerWord;
+        if ((bitmap_[word] & bit) == 0) {
+            diag_event(DiagEvent::DoubleFree, ptr, index);
+            return false;  // Block already free
+        }
+
+        bitmap_[word] &= ~bit;
+        --used_blocks_count_;
+        if (word < search_hint_) {
+            search_hint_ = word;
+        }
+        diag_event(DiagEvent::Deallocated, ptr, index);
+        return true;
+    }
+
+    bool is_valid_pointer(void* ptr) const {
+        // Pointers before storage_ give a wrapped offset far above kPoolSize
+        size_t offset = reinterpret_cast<uintptr_t>(ptr) - reinterpret_cast<uintptr_t>(storage_);
+        return offset < kPoolSize && offset % kBlockSize == 0;
+    }
+
+    // Statistics methods
+    static constexpr size_t get_block_size() { return kBlockSize; }
+    static constexpr size_t get_total_blocks() { return kNumBlocks; }
+    static constexpr size_t get_alignment() { return kAlignment; }
+    const void* get_pool_base() const { return storage_; }
+    size_t get_free_blocks() const { return kNumBlocks - used_blocks_count_; }
+    size_t get_used_blocks() const { return used_blocks_count_; }
+    bool is_full() const { return used_blocks_count_ == kNumBlocks; }
+    bool is_empty() const { return used_blocks_count_ == 0; }
+
+private:
+    static constexpr size_t kBitsPerWord = 64;
+    static constexpr uint64_t kFullWord = ~uint64_t(0);
+    static constexpr size_t kWords = (NumBlocks + kBitsPerWord - 1) / kBitsPerWord;
+
+    // Member variables
+    alignas(kAlignment) unsigned char storage_[kPoolSize];
+    std::array<uint64_t, kWords> bitmap_;  // 1 bit per block: 0 = free, 1 = used; tail bits stay 0
+    size_t used_blocks_count_;             // Counted up so the initial state is all zeros
+    size_t search_hint_;                   // No free block in the words below this one
+};
@@ -0,0 +1,236 @@
+#include "tlsfAlloc.h"
+#include "allocDiagnostics.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// Index of the highest / lowest set bit; value must be non-zero
+size_t find_last_set(uint64_t value) {
+    return 63 - static_cast<size_t>(__builtin_clzll(value));
+}
+
+size_t find_first_set(uint64_t value) {
+    return static_cast<size_t>(__builtin_ctzll(value));
+}
+
+}  // namespace
+
+TlsfAllocator::TlsfAllocator(size_t region_size, PoolBacking backing)
+    : fl_count_(0)
+    , max_allocation_(0)
+    , used_bytes_(0)
+    , used_blocks_(0)
+    , fl_bitmap_(0)
+{
+    // Input validation: one block plus the sentinel that ends the region
+    region_size &= ~(kAlignment - 1);
+    if (region_size < 2 * kBlockOverhead + kMinBlock) {
+        throw std::invalid_argument("Region too small for one block");
+    }
+    
+    region_ = allocate_pool_region(region_size, kAlignment, backing);
+    
+    // Touch every page now rather than on the allocation path
+    std::memset(region_.base, 0, region_.size);
+    
+    // One free block spanning the region, then a zero-size used sentinel
+    // so next_phys() of the last real block is always a header
+    size_t first_size = region_.size - 2 * kBlockOverhead;
+    fl_count_ = find_last_set(first_size) - (kFlShift - 1) + 1;
+    if (first_size < kSmallBlock) {
+        fl_count_ = 1;
+    }
+    sl_bitmaps_.assign(fl_count_, 0);
+    free_lists_.resize(fl_count_);
+    for (auto& lists : free_lists_) {
+        lists.fill(nullptr);
+    }
+    
+    // The largest request the empty region serves: the start of the list
+    // the whole-region block sits on (find_free rounds requests up)
+    max_allocation_ = first_size < kSmallBlock
+        ? first_size
+        : first_size & ~((size_t(1) << (find_last_set(first_size) - kSlLog2)) - 1);
+    
+    Block* first = reinterpret_cast<Block*>(region_.base);
+    first->prev_phys = nullptr;
+    first->size_flags = first_size | kFreeBit;
+    Block* sentinel = next_phys(first);
+    sentinel->prev_phys = first;
+    sentinel->size_flags = kPrevFreeBit;
+    insert_free(first);
+}
+
+TlsfAllocator::~TlsfAllocator() {
+    release_pool_region(region_);
+}
+
+void* TlsfAllocator::allocate(size_t size) {
+    if (size > max_allocation_) {
+        return nullptr;  // Larger than the region
+    }
+    size = size < kMinBlock ? kMinBlock : (size + kAlignment - 1) & ~(kAlignment - 1);
+    
+    size_t fl;
+    size_t sl;
+    Block* block = find_free(size, fl, sl);
+    if (!block) {
+        return nullptr;  // No free block large enough
+    }
+    remove_free(block, fl, sl);
+    
+    // Split off the tail if it can hold a block of its own
+    size_t block_size = size_of(block);
+    if (block_size >= size + kBlockOverhead + kMinBlock) {
+        block->size_flags = size | (block->size_flags & kPrevFreeBit);
+        Block* rest = next_phys(block);
+        rest->prev_phys = block;
+        rest->size_flags = (block_size - size - kBlockOverhead) | kFreeBit;
+        next_phys(rest)->prev_phys = rest;  // Its kPrevFreeBit is already set
+        insert_free(rest);
+    } else {
+        block->size_flags &= ~kFreeBit;
+        next_phys(block)->size_flags &= ~kPrevFreeBit;
+    }
+    
+    used_bytes_ += size_of(block) + kBlockOverhead;
+    ++used_blocks_;
+    return reinterpret_cast<uint8_t*>(block) + kBlockOverhead;
+}
+
+bool TlsfAllocator::deallocate(void* ptr) {
+    size_t offset = payload_offset(ptr);
+    if (offset == 0) {
+        diag_event(DiagEvent::InvalidPointer, ptr);
+        return false;  // Invalid pointer
+    }
+    
+    Block* block = reinterpret_cast<Block*>(static_cast<uint8_t*>(ptr) - kBlockOverhead);
+    if (block->size_flags & kFreeBit) {
+        diag_event(DiagEvent::DoubleFree, ptr, offset);
+        return false;  // Block already free
+    }
+    used_bytes_ -= size_of(block) + kBlockOverhead;
+    --used_blocks_;
+    
+    // Flag the header free before it can become the inside of a merged
+    // block, so freeing ptr again is still caught as a double free
+    block->size_flags |= kFreeBit;
+    
+    // Merge with the previous block, then the next, if they are free
+    size_t prev_free = block->size_flags & kPrevFreeBit;
+    if (prev_free) {
+        Block* prev = block->prev_phys;
+        remove_free(prev);
+        prev->size_flags += kBlockOverhead + size_of(block);
+        block = prev;
+    }
+    Block* next = next_phys(block);
+    if (next->size_flags & kFreeBit) {
+        remove_free(next);
+        block->size_flags += kBlockOverhead + size_of(next);
+        next = next_phys(block);
+    }
+    
+    next->prev_phys = block;
+    next->size_flags |= kPrevFreeBit;
+    insert_free(block);
+    
+    diag_event(DiagEvent::Deallocated, ptr, offset);
+    return true;
+}
+
+size_t TlsfAllocator::block_size_of(const void* ptr) const {
+    if (payload_offset(ptr) == 0) {
+        return 0;
+    }
+    const Block* block = reinterpret_cast<const Block*>(static_cast<const uint8_t*>(ptr) - kBlockOverhead);
+    return (block->size_flags & kFreeBit) ? 0 : size_of(block);
+}
+
+size_t TlsfAllocator::payload_offset(const void* ptr) const {
+    // Payloads start one header past a block boundary, so offset 0 (the
+    // first header) and the end sentinel's payload are never valid; a
+    // pointer below the region wraps to a huge offset and fails the bound
+    size_t offset = reinterpret_cast<uintptr_t>(ptr) - reinterpret_cast<uintptr_t>(region_.base);
+    if (offset < kBlockOverhead || offset >= region_.size - kBlockOverhead || offset % kAlignment != 0) {
+        return 0;
+    }
+    return offset;
+}
+
+void TlsfAllocator::mapping_insert(size_t size, size_t& fl, size_t& sl) {
+    // List a free block of this size belongs on
+    if (size < kSmallBlock) {
+        fl = 0;
+        sl = size / (kSmallBlock / kSlCount);
+    } else {
+        size_t top = find_last_set(size);
+        sl = (size >> (top - kSlLog2)) ^ kSlCount;  // The kSlLog2 bits below the top one
+        fl = top - (kFlShift - 1);
+    }
+}
+
+TlsfAllocator::Block* TlsfAllocator::find_free(size_t size, size_t& fl, size_t& sl) const {
+    // Round up to the next list boundary so any block on the list found fits
+    if (size >= kSmallBlock) {
+        size += (size_t(1) << (find_last_set(size) - kSlLog2)) - 1;
+    }
+    mapping_insert(size, fl, sl);
+    if (fl >= fl_count_) {
+        return nullptr;
+    }
+    
+    // A non-empty list at this first level, or else the next non-empty level up
+    uint32_t sl_map = sl_bitmaps_[fl] & (~uint32_t(0) << sl);
+    if (sl_map == 0) {
+        uint64_t fl_map = fl + 1 < 64 ? fl_bitmap_ & (~uint64_t(0) << (fl + 1)) : 0;
+        if (fl_map == 0) {
+            return nullptr;
+        }
+        fl = find_first_set(fl_map);
+        sl_map = sl_bitmaps_[fl];
+    }
+    sl = find_first_set(sl_map);
+    return free_lists_[fl][sl];
+}
+
+void TlsfAllocator::insert_free(Block* block) {
+    size_t fl;
+    size_t sl;
+    mapping_insert(size_of(block), fl, sl);
+    Block* head = free_lists_[fl][sl];
+    block->next_free = head;
+    block->prev_free = nullptr;
+    if (head) {
+        head->prev_free = block;
+    }
+    free_lists_[fl][sl] = block;
+    sl_bitmaps_[fl] |= uint32_t(1) << sl;
+    fl_bitmap_ |= uint64_t(1) << fl;
+}
+
+void TlsfAllocator::remove_free(Block* block, size_t fl, size_t sl) {
+    if (block->prev_free) {
+        block->prev_free->next_free = block->next_free;
+    } else {
+        free_lists_[fl][sl] = block->next_free;
+    }
+    if (block->next_free) {
+        block->next_free->prev_free = block->prev_free;
+    }
+    if (!free_lists_[fl][sl]) {
+        sl_bitmaps_[fl] &= ~(uint32_t(1) << sl);
+        if (sl_bitmaps_[fl] == 0) {
+            fl_bitmap_ &= ~(uint64_t(1) << fl);
+        }
+    }
+}
+
+void TlsfAllocator::remove_free(Block* block) {
+    size_t fl;
+    size_t sl;
+    mapping_insert(size_of(block), fl, sl);
+    remove_free(block, fl, sl);
+}
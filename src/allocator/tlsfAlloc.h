@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "poolMemory.h"
+
+/**
+ * Two-level segregated fit (TLSF) allocator: variable sizes from one fixed
+ * region with O(1) allocate and deallocate, no loops over blocks or lists.
+ *
+ * Free blocks live on segregated lists: the first level splits sizes by
+ * power of two, the second splits every power of two into 32 equal
+ * ranges (16-byte steps below 512 bytes). A first-level bitmap and one
+ * second-level bitmap per first level record which lists are non-empty,
+ * so finding a list with a block that fits is two bit scans (ffs/fls).
+ * Sizes are rounded up to the start of the next range before the search,
+ * so the head of the list found always fits (good fit, not best fit).
+ *
+ * Every block has a 16-byte header holding its size, its free flag, a
+ * flag saying whether the block before it is free, and a pointer to that
+ * block (boundary tags), so deallocate() merges with both physical
+ * neighbours in constant time. The region comes from
+ * allocate_pool_region() and is touched up front, so no page fault hits
+ * the allocation path. Returned pointers are 16-byte aligned.
+ * Not thread-safe.
+ */
+class TlsfAllocator {
+public:
+    static constexpr size_t kAlignment = 16;
+    static constexpr size_t kBlockOverhead = 16;  // Header bytes per block
+
+    explicit TlsfAllocator(size_t region_size, PoolBacking backing = PoolBacking::Heap);
+    ~TlsfAllocator();
+
+    // Delete copy constructor and assignment operator
+    TlsfAllocator(const TlsfAllocator&) = delete;
+    TlsfAllocator& operator=(const TlsfAllocator&) = delete;
+
+    // nullptr if no free block is large enough
+    void* allocate(size_t size);
+
+    // ptr must come from allocate(). Pointers outside the region are
+    // detected, and so is a second free of a block until its memory is
+    // handed out again (even after it was merged into a neighbour)
+    bool deallocate(void* ptr);
+
+    // Usable size of the block ptr points to (may exceed the requested size)
+    size_t block_size_of(const void* ptr) const;
+
+    // Statistics methods
+    size_t get_capacity() const { return region_.size; }
+    size_t get_max_allocation() const { return max_allocation_; }  // Largest request an empty region serves
+    size_t get_used_bytes() const { return used_bytes_; }      // In allocated blocks, headers included
+    size_t get_used_blocks() const { return used_blocks_; }
+    size_t get_free_bytes() const { return region_.size - kBlockOverhead - used_bytes_; }  // All but the end sentinel
+    PoolBacking get_backing() const { return region_.backing; }
+
+private:
+    static constexpr size_t kSlLog2 = 5;
+    static constexpr size_t kSlCount = size_t(1) << kSlLog2;  // Second-level lists per first level
+    static constexpr size_t kFlShift = kSlLog2 + 4;           // log2(kSmallBlock)
+    static constexpr size_t kSmallBlock = size_t(1) << kFlShift;  // Below this, first level 0 in 16-byte steps
+    static constexpr size_t kMinBlock = 16;                   // Room for the free-list links
+    static constexpr size_t kFreeBit = 1;
+    static constexpr size_t kPrevFreeBit = 2;
+    static constexpr size_t kFlagBits = kFreeBit | kPrevFreeBit;
+
+    // Boundary tag at the start of every block; the payload follows it.
+    // The list links overlay the first payload bytes of free blocks.
+    struct Block {
+        Block* prev_phys;   // Physically previous block (valid while it is free)
+        size_t size_flags;  // Payload size | kFreeBit | kPrevFreeBit
+        Block* next_free;
+        Block* prev_free;
+    };
+
+    // Helper methods
+    static size_t size_of(const Block* block) { return block->size_flags & ~kFlagBits; }
+    static Block* next_phys(Block* block) {
+        return reinterpret_cast<Block*>(reinterpret_cast<uint8_t*>(block) + kBlockOverhead + size_of(block));
+    }
+    size_t payload_offset(const void* ptr) const;  // Offset of ptr in the region, 0 if it can't be a payload
+    static void mapping_insert(size_t size, size_t& fl, size_t& sl);
+    Block* find_free(size_t size, size_t& fl, size_t& sl) const;
+    void insert_free(Block* block);
+    void remove_free(Block* block, size_t fl, size_t sl);
+    void remove_free(Block* block);
+
+    // Member variables
+    PoolRegion region_;
+    size_t fl_count_;        // First-level lists in use: enough for the whole region
+    size_t max_allocation_;
+    size_t used_bytes_;
+    size_t used_blocks_;
+    uint64_t fl_bitmap_;                            // Bit fl set when sl_bitmaps_[fl] != 0
+    std::vector<uint32_t> sl_bitmaps_;              // Per first level: bit sl set when its list is non-empty
+    std::vector<std::array<Block*, kSlCount>> free_lists_;
+};
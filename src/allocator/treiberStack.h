@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "fixAlloc.h"
+
+/**
+ * Lock-free LIFO of free blocks (a Treiber stack) threaded through the
+ * blocks themselves, safe for any number of pushing and popping threads.
+ *
+ * The head packs the top block's slot (index + 1, 0 = empty) in the low
+ * 40 bits with a 24-bit version tag above it. Every successful push and
+ * pop bumps the tag, so a pop whose CAS straddles another thread's
+ * pop-then-push of the same block fails instead of installing a stale next
+ * link (the ABA problem). Packing an index rather than a raw pointer gives
+ * the tag 24 bits with an ordinary 64-bit CAS and makes no assumptions
+ * about which address bits are unused.
+ */
+class TreiberFreeStack {
+public:
+    static constexpr size_t kMaxBlocks = (size_t(1) << 40) - 1;
+    
+    TreiberFreeStack() : base_(nullptr), stride_(0), head_(0) {}
+    
+    // Attach to a pool of equally sized blocks; the stack starts empty
+    void reset(uint8_t* base, size_t stride) {
+        base_ = base;
+        stride_ = stride;
+        head_.store(0, std::memory_order_relaxed);
+    }
+    
+    void push(void* block) {
+        push_chain(block, block);
+    }
+    
+    // Push first..last in one CAS; the blocks in between must already be
+    // linked with link()
+    void push_chain(void* first, void* last) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        uint64_t desired;
+        do {
+            next_of(last).store(head & kSlotMask, std::memory_order_relaxed);
+            desired = pack(slot_of(first), head);
+        } while (!head_.compare_exchange_weak(head, desired, std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+    
+    // Set block's next link for a chain passed to push_chain()
+    void link(void* block, void* next) {
+        next_of(block).store(slot_of(next), std::memory_order_relaxed);
+    }
+    
+    void* pop() {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        while ((head & kSlotMask) != 0) {
+            void* block = block_of(head & kSlotMask);
+            // May read a block another thread just popped and is writing;
+            // the tag then makes the CAS below fail and we retry
+            uint64_t next = next_of(block).load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(head, pack(next, head), std::memory_order_acquire,
+                                            std::memory_order_acquire)) {
+                return block;
+            }
+        }
+        return nullptr;  // Stack empty
+    }
+    
+    bool empty() const {
+        return (head_.load(std::memory_order_relaxed) & kSlotMask) == 0;
+    }
+
+private:
+    static constexpr unsigned kSlotBits = 40;
+    static constexpr uint64_t kSlotMask = (uint64_t(1) << kSlotBits) - 1;
+    
+    // New head holding slot, with the tag of old_head incremented (wraps at 24 bits)
+    static uint64_t pack(uint64_t slot, uint64_t old_head) {
+        return (((old_head >> kSlotBits) + 1) << kSlotBits) | slot;
+    }
+    
+    // The next link lives in the first 8 bytes of each free block
+    static std::atomic<uint64_t>& next_of(void* block) {
+        return *static_cast<std::atomic<uint64_t>*>(block);
+    }
+    
+    uint64_t slot_of(void* block) const {
+        return block ? static_cast<uint64_t>((static_cast<uint8_t*>(block) - base_) / stride_) + 1 : 0;
+    }
+    
+    void* block_of(uint64_t slot) const {
+        return base_ + (slot - 1) * stride_;
+    }
+    
+    uint8_t* base_;
+    size_t stride_;
+    alignas(kCacheLineSize) std::atomic<uint64_t> head_;
+};